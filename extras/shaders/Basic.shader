@@ -4,8 +4,13 @@
 layout (location = 0) in vec4 aPosition;
 
 uniform mat4 uTransform;
-uniform mat4 uProjection;
-uniform mat4 uView;
+
+layout (std140) uniform Frame
+{
+    mat4 uView;
+    mat4 uProjection;
+    vec4 uCameraPosition;
+};
 
 void main()
 {
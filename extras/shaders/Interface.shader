@@ -2,12 +2,15 @@
 #version 330 core
 layout (location = 0) in vec3 aPosition;
 layout (location = 1) in vec2 aTexCoords;
+layout (location = 2) in float aTextureIndex;
 
 out vec2 fTexCoords;
+flat out int fTextureIndex;
 
 void main()
 {
     fTexCoords = aTexCoords;
+    fTextureIndex = int(aTextureIndex);
     gl_Position = vec4(aPosition, 1.0);
 };
 
@@ -17,10 +20,28 @@ void main()
 out vec4 FragColor;
 
 in vec2 fTexCoords;
+flat in int fTextureIndex;
 
-uniform sampler2D uTexture;
+// Todas as texturas da interface ficam ligadas ao mesmo tempo para a interface ser desenhada em uma única chamada
+// O GLSL 3.30 só indexa arrays de samplers com constantes, então cada textura tem o seu uniform
+uniform sampler2D uAtlas;
+uniform sampler2D uCrosshair;
+uniform sampler2D uHotbar;
+uniform sampler2D uHotbarSelector;
 
 void main()
 {
-    FragColor = texture(uTexture, fTexCoords);
-};
\ No newline at end of file
+    vec4 atlas = texture(uAtlas, fTexCoords);
+    vec4 crosshair = texture(uCrosshair, fTexCoords);
+    vec4 hotbar = texture(uHotbar, fTexCoords);
+    vec4 hotbarSelector = texture(uHotbarSelector, fTexCoords);
+
+    if (fTextureIndex == 0)
+        FragColor = atlas;
+    else if (fTextureIndex == 1)
+        FragColor = crosshair;
+    else if (fTextureIndex == 2)
+        FragColor = hotbar;
+    else
+        FragColor = hotbarSelector;
+};
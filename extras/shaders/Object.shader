@@ -6,8 +6,13 @@ layout (location = 1) in vec4 normal_coefficients;
 layout (location = 2) in vec2 texture_coefficients;
 
 uniform mat4 uModel;
-uniform mat4 uView;
-uniform mat4 uProjection;
+
+layout (std140) uniform Frame
+{
+    mat4 uView;
+    mat4 uProjection;
+    vec4 uCameraPosition;
+};
 
 uniform int uIsGouraud;
 
@@ -24,8 +29,7 @@ void main()
     fNormal.w = 0.0;
 
     if (uIsGouraud == 1) {
-        vec4 origin = vec4(0.0, 0.0, 0.0, 1.0);
-        vec4 camera_position = inverse(uView) * origin;
+        vec4 camera_position = uCameraPosition;
 
         vec4 p = fPositionWorld;
 
@@ -69,9 +73,14 @@ in vec4 fNormal;
 
 varying vec4 fGouraudColor;
 
-uniform mat4 uView;
+layout (std140) uniform Frame
+{
+    mat4 uView;
+    mat4 uProjection;
+    vec4 uCameraPosition;
+};
+
 uniform mat4 uModel;
-uniform mat4 uProjection;
 
 uniform int uIsGouraud;
 
@@ -82,8 +91,7 @@ void main()
     if (uIsGouraud == 1) {
         FragColor = fGouraudColor;
     } else {
-        vec4 origin = vec4(0.0, 0.0, 0.0, 1.0);
-        vec4 camera_position = inverse(uView) * origin;
+        vec4 camera_position = uCameraPosition;
 
         vec4 p = fPositionWorld;
 
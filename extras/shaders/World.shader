@@ -1,22 +1,53 @@
 #shader vertex
 #version 330 core
-layout (location = 0) in vec3 aPosition;
-layout (location = 1) in vec2 aTextureCoord;
-layout (location = 2) in vec3 aNormal;
+layout (location = 0) in uint aPosition;
+layout (location = 1) in uint aTexture;
 
-uniform mat4 uTransform;
-uniform mat4 uProjection;
-uniform mat4 uView;
+layout (std140) uniform Frame
+{
+    mat4 uView;
+    mat4 uProjection;
+    vec4 uCameraPosition;
+};
+
+uniform vec2 uTileSize;
+
+// Origem horizontal do chunk dono de cada página da arena de vértices
+uniform isamplerBuffer uPageOrigins;
+uniform int uPageVertices;
 
 out vec2 fTextureCoord;
 out vec3 fNormal;
+flat out vec2 fTileOrigin;
+
+// Normais na ordem das faces do cubo: frente, direita, trás, esquerda, topo e base
+const vec3 normals[6] = vec3[6](
+    vec3(0.0, 0.0, 1.0),
+    vec3(1.0, 0.0, 0.0),
+    vec3(0.0, 0.0, -1.0),
+    vec3(-1.0, 0.0, 0.0),
+    vec3(0.0, 1.0, 0.0),
+    vec3(0.0, -1.0, 0.0));
 
 void main()
 {
-    fTextureCoord = aTextureCoord;
-    fNormal = aNormal;
+    // Desempacota a posição local ao chunk (x 5 bits, y 9 bits, z 5 bits) e a face (3 bits)
+    vec3 position = vec3(aPosition & 31u, (aPosition >> 5) & 511u, (aPosition >> 14) & 31u);
+    uint face = (aPosition >> 19) & 7u;
+
+    // Desempacota o tile do atlas (8 bits) e as coordenadas locais ao tile (5 bits cada)
+    uint tile = aTexture & 255u;
+    int atlasColumns = int(round(1.0 / uTileSize.x));
+    int atlasRows = int(round(1.0 / uTileSize.y));
+
+    fTextureCoord = vec2((aTexture >> 8) & 31u, (aTexture >> 13) & 31u);
+    fNormal = normals[face];
+    fTileOrigin = vec2(int(tile) % atlasColumns, (atlasRows - 1) - int(tile) / atlasColumns) * uTileSize;
+
+    // Em glMultiDrawArrays, gl_VertexID é a posição do vértice na arena
+    ivec2 origin = texelFetch(uPageOrigins, gl_VertexID / uPageVertices).xy;
 
-    gl_Position = uProjection * uView * (uTransform * vec4(aPosition, 1.0));
+    gl_Position = uProjection * uView * vec4(position + vec3(origin.x, 0.0, origin.y), 1.0);
 };
 
 #shader fragment
@@ -24,9 +55,11 @@ void main()
 
 in vec2 fTextureCoord;
 in vec3 fNormal;
+flat in vec2 fTileOrigin;
 
 uniform int uIsOpaque;
 uniform sampler2D uTexture;
+uniform vec2 uTileSize;
 
 out vec4 FragColor;
 
@@ -35,7 +68,8 @@ const float minLightStrength = 0.3f;
 
 void main()
 {
-    vec4 textureColor = texture(uTexture, fTextureCoord);
+    // As coordenadas se repetem a cada bloco, para que faces unidas pelo greedy meshing não estiquem a textura
+    vec4 textureColor = texture(uTexture, fTileOrigin + fract(fTextureCoord) * uTileSize);
 
     float lightStrength = clamp(-dot(fNormal, lightSourceDirection), 0, 1);
     lightStrength = max(minLightStrength, lightStrength);
@@ -0,0 +1,70 @@
+#ifndef _BUFFERALLOCATOR_H
+#define _BUFFERALLOCATOR_H
+
+#include <map>
+#include <vector>
+
+// Sub-alocador de um intervalo contíguo de unidades [0, capacidade), usado para dividir um buffer de GPU
+// Cada alocação é identificada por um handle estável, que continua válido quando a desfragmentação a move
+class BufferAllocator
+{
+public:
+  static const int INVALID = -1;
+
+  // Alocação deslocada pela desfragmentação, para o dono do buffer copiar o conteúdo
+  struct Move
+  {
+    int handle;
+    int oldOffset;
+    int newOffset;
+    int size;
+  };
+
+private:
+  struct Allocation
+  {
+    int offset;
+    int size; // Zero em handles livres
+  };
+
+  int m_Capacity;
+  int m_Used;
+
+  std::vector<Allocation> m_Allocations;
+  std::vector<int> m_FreeHandles;
+
+  // Blocos livres por posição, sempre unidos com os vizinhos livres
+  std::map<int, int> m_FreeBlocks;
+
+  void AddFreeBlock(int offset, int size);
+
+public:
+  BufferAllocator(int capacity);
+
+  // Reserva size unidades contíguas no menor bloco livre que as comporta
+  // Retorna o handle da alocação, ou INVALID se nenhum bloco livre é grande o suficiente
+  int Allocate(int size);
+  void Free(int handle);
+
+  int GetOffset(int handle) const { return m_Allocations[handle].offset; }
+  int GetSize(int handle) const { return m_Allocations[handle].size; }
+
+  // Aumenta a capacidade, estendendo o último bloco livre se ele termina no fim do intervalo
+  void Grow(int capacity);
+
+  // Move todas as alocações para o início do intervalo, na ordem atual, deixando um único bloco livre no fim
+  // Retorna as alocações que mudaram de posição, em ordem crescente
+  std::vector<Move> Defragment();
+
+  int GetCapacity() const { return m_Capacity; }
+  int GetUsed() const { return m_Used; }
+  int GetFree() const { return m_Capacity - m_Used; }
+  int GetAllocationCount() const { return static_cast<int>(m_Allocations.size() - m_FreeHandles.size()); }
+  int GetFreeBlockCount() const { return static_cast<int>(m_FreeBlocks.size()); }
+  int GetLargestFreeBlock() const;
+
+  // Fração do espaço livre fora do maior bloco livre: 0 com um único bloco, perto de 1 com muitos buracos pequenos
+  float GetFragmentation() const;
+};
+
+#endif
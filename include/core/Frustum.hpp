@@ -0,0 +1,28 @@
+#ifndef _FRUSTUM_H
+#define _FRUSTUM_H
+
+#include <array>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+// Frustum de visualização, com os seis planos extraídos da matriz projeção * view (método de Gribb e Hartmann)
+class Frustum
+{
+private:
+  // Planos (a, b, c, d) com a normal apontando para dentro: um ponto p está dentro se a*x + b*y + c*z + d >= 0
+  std::array<glm::vec4, 6> m_Planes;
+
+public:
+  // Funciona com as matrizes de Camera::ComputeViewMatrix e ComputeProjectionMatrix, perspectiva ou ortográfica
+  Frustum(const glm::mat4 &viewProjection);
+
+  // Testa se uma caixa alinhada aos eixos está ao menos parcialmente dentro do frustum
+  // O teste é conservador: caixas próximas dos cantos do frustum podem ser consideradas visíveis
+  bool IsBoxVisible(const glm::vec3 &min, const glm::vec3 &max) const;
+
+  const glm::vec4 &GetPlane(int plane) const { return m_Planes[plane]; }
+};
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef _OCCLUSIONBUFFER_H
+#define _OCCLUSIONBUFFER_H
+
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+// Buffer de profundidade em baixa resolução rasterizado na CPU, para descartar objetos escondidos atrás de oclusores grandes
+// Guarda a profundidade (z em NDC, menor é mais perto) do oclusor mais próximo em cada pixel
+class OcclusionBuffer
+{
+public:
+  // Resolução com a guard band de um pixel em volta da tela
+  // Largura múltipla de 4 para a rasterização em grupos de 4 pixels
+  static const int WIDTH = 256;
+  static const int HEIGHT = 128;
+
+private:
+  std::vector<float> m_Depth;
+
+  glm::mat4 m_ViewProjection;
+  glm::vec3 m_Eye;
+
+  int m_TriangleCount;
+
+  // Rasteriza um quadrilátero em clip space, recortado no plano near
+  void DrawQuad(const glm::vec4 corners[4]);
+  void DrawTriangle(glm::vec3 a, glm::vec3 b, glm::vec3 c);
+
+public:
+  OcclusionBuffer();
+
+  // Esvazia o buffer e define a câmera usada pelos próximos oclusores e testes
+  // eye é a posição da câmera, usada para rasterizar só as faces dos oclusores voltadas para ela
+  void Clear(const glm::mat4 &viewProjection, const glm::vec3 &eye);
+
+  // Rasteriza uma caixa que é totalmente opaca
+  void AddOccluder(const glm::vec3 &min, const glm::vec3 &max);
+
+  // Testa se a caixa está inteiramente atrás dos oclusores em todos os pixels que ela cobre
+  // Caixas que cruzam o plano near nunca são consideradas oclusas
+  bool IsBoxOccluded(const glm::vec3 &min, const glm::vec3 &max) const;
+
+  float GetDepth(int x, int y) const { return m_Depth[y * WIDTH + x]; }
+
+  // Triângulos rasterizados desde o último Clear
+  int GetTriangleCount() const { return m_TriangleCount; }
+};
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef _PROFILER_H
+#define _PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Intervalo medido por uma zona, em nanossegundos desde o início do profiler
+struct ProfileEvent
+{
+  int zone;
+  uint64_t begin;
+  uint64_t end;
+};
+
+// Durações recentes de uma zona, em milissegundos
+struct ZoneStats
+{
+  const char *name;
+  int frameCalls; // Eventos coletados no último Collect
+  int samples;    // Eventos na janela usada pelos percentis
+  float p50;
+  float p95;
+  float p99;
+};
+
+// Fila circular de eventos de uma thread: só a thread dona escreve e só o Collect lê,
+// então cada lado avança o próprio índice atômico e nenhum dos dois trava
+class ProfileRing
+{
+public:
+  static const uint32_t CAPACITY = 16384;
+
+private:
+  ProfileEvent m_Events[CAPACITY];
+
+  std::atomic<uint32_t> m_Head; // Próxima escrita
+  std::atomic<uint32_t> m_Tail; // Próxima leitura
+
+  // Eventos descartados com a fila cheia
+  std::atomic<uint32_t> m_Dropped;
+
+public:
+  ProfileRing();
+
+  void Push(const ProfileEvent &event);
+
+  // Move os eventos pendentes para o fim do vetor
+  void Drain(std::vector<ProfileEvent> &events);
+
+  uint32_t GetDropped() const { return m_Dropped.load(std::memory_order_relaxed); }
+};
+
+// Profiler de zonas: cada zona marcada com PROFILE_ZONE mede o tempo até o fim do escopo
+// As threads gravam os eventos nas próprias filas sem travas; uma vez por frame a thread principal os coleta
+// para os percentis de cada zona e, durante uma captura, para um trace no formato do Chrome (chrome://tracing)
+class Profiler
+{
+private:
+  Profiler() {}
+
+public:
+  static const int MAX_ZONES = 64;
+
+  // Eventos guardados por zona para os percentis
+  static const int WINDOW_SIZE = 256;
+
+  // Nanossegundos desde o início do profiler, pelo relógio monotônico
+  static uint64_t Now();
+
+  // Chamado uma vez por zona, na primeira execução do PROFILE_ZONE
+  static int RegisterZone(const char *name);
+
+  static void Record(int zone, uint64_t begin, uint64_t end);
+
+  // Nome da thread atual no trace
+  static void SetThreadName(const char *name);
+
+  static void SetEnabled(bool isEnabled);
+  static bool IsEnabled();
+
+  // Coleta os eventos de todas as threads; deve ser chamado uma vez por frame, na thread principal
+  static void Collect();
+
+  // Guarda os eventos dos próximos frames e escreve o trace no arquivo quando eles terminam
+  static void StartCapture(int frames, const std::string &path);
+  static bool IsCapturing();
+
+  // Escreve os eventos capturados até agora como JSON do Chrome trace
+  static bool WriteChromeTrace(const std::string &path);
+
+  // Zonas com eventos na janela, na ordem de registro
+  static std::vector<ZoneStats> GetZoneStats();
+
+  static uint32_t GetDroppedEvents();
+};
+
+// Mede o escopo em que é criado
+class ProfileScope
+{
+private:
+  int m_Zone;
+  bool m_IsRecording;
+  uint64_t m_Begin;
+
+public:
+  ProfileScope(int zone)
+      : m_Zone(zone),
+        m_IsRecording(Profiler::IsEnabled()),
+        m_Begin(m_IsRecording ? Profiler::Now() : 0)
+  {
+  }
+
+  ~ProfileScope()
+  {
+    if (m_IsRecording)
+      Profiler::Record(m_Zone, m_Begin, Profiler::Now());
+  }
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+// Marca o resto do escopo como uma zona; o nome deve ser uma string literal
+#define PROFILE_ZONE(name)                                                               \
+  static const int PROFILE_CONCAT(profileZone, __LINE__) = Profiler::RegisterZone(name); \
+  ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(PROFILE_CONCAT(profileZone, __LINE__))
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef _RANDOM_H
+#define _RANDOM_H
+
+#include <cstdint>
+
+// Gerador aleatório baseado em contador: o valor é um hash da semente e da posição,
+// então não tem estado, é seguro entre threads e não depende da ordem de geração
+namespace Random
+{
+  // Finalizador de hash de 32 bits com boa difusão de bits
+  inline uint32_t Mix(uint32_t value)
+  {
+    value ^= value >> 16;
+    value *= 0x7feb352dU;
+    value ^= value >> 15;
+    value *= 0x846ca68bU;
+    value ^= value >> 16;
+
+    return value;
+  }
+
+  // Parte do hash que depende só da semente, do stream e de x
+  // Permite reaproveitar o prefixo ao percorrer uma coluna inteira
+  inline uint32_t HashPrefix(uint32_t seed, uint32_t stream, int x)
+  {
+    uint32_t value = Mix(seed ^ (stream * 0x9e3779b9U));
+
+    return Mix(value ^ static_cast<uint32_t>(x));
+  }
+
+  // Completa o hash a partir do prefixo; igual a Hash(seed, stream, x, y, z)
+  inline uint32_t HashFromPrefix(uint32_t prefix, int y, int z)
+  {
+    uint32_t value = Mix(prefix ^ static_cast<uint32_t>(y));
+
+    return Mix(value ^ static_cast<uint32_t>(z));
+  }
+
+  // Valor aleatório para uma posição; streams diferentes geram sequências independentes
+  inline uint32_t Hash(uint32_t seed, uint32_t stream, int x, int y, int z)
+  {
+    return HashFromPrefix(HashPrefix(seed, stream, x), y, z);
+  }
+
+  // Valor aleatório entre 0 e range - 1
+  inline int Range(uint32_t seed, uint32_t stream, int x, int y, int z, int range)
+  {
+    return static_cast<int>(Hash(seed, stream, x, y, z) % static_cast<uint32_t>(range));
+  }
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef _THREADPOOL_H
+#define _THREADPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef std::function<void()> JobType;
+
+// Classe para execução de tarefas em paralelo em um conjunto fixo de threads
+class ThreadPool
+{
+private:
+  std::vector<std::thread> m_Workers;
+
+  std::deque<JobType> m_Jobs;
+
+  // Tarefas que passam na frente das demais, como as geradas por ações do jogador
+  std::deque<JobType> m_PriorityJobs;
+
+  std::mutex m_Mutex;
+  std::condition_variable m_JobAvailable;
+  std::condition_variable m_JobsFinished;
+
+  int m_ActiveJobs;
+  bool m_IsStopping;
+
+  void WorkerLoop();
+
+public:
+  // Com zero threads, usa uma thread por núcleo do processador
+  ThreadPool(int threadCount = 0);
+  ~ThreadPool();
+
+  // Tarefas com prioridade são executadas antes de todas as tarefas normais ainda na fila
+  void Submit(JobType job, bool isPriority = false);
+
+  // Bloqueia até que todas as tarefas enviadas tenham terminado
+  void Wait();
+
+  int GetThreadCount() const { return static_cast<int>(m_Workers.size()); }
+};
+
+#endif
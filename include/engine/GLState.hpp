@@ -0,0 +1,105 @@
+#ifndef _GLSTATE_H
+#define _GLSTATE_H
+
+#include <unordered_map>
+
+// Chamadas de mudança de estado no último frame
+struct GLStateStats
+{
+  int issued; // Enviadas ao driver
+  int elided; // Descartadas por não mudarem o estado atual
+};
+
+// Cache do estado do OpenGL usado pelo engine: programa, VAO, buffers, texturas, blend, depth test e polygon mode
+// Toda mudança desse estado deve passar por aqui; chamadas que não mudam nada não chegam ao driver
+// Começa com os valores padrão de um contexto recém-criado
+class GLState
+{
+private:
+  GLState() {}
+
+  // Valor guardado quando o estado real é desconhecido, para a próxima chamada sempre ser enviada
+  static const unsigned int UNKNOWN = 0xFFFFFFFF;
+
+  static const int MAX_TEXTURE_UNITS = 16;
+  static const int MAX_UNIFORM_BINDINGS = 16;
+
+  enum BufferTarget
+  {
+    BT_ARRAY,
+    BT_UNIFORM,
+    BT_TEXTURE,
+    BT_COPY_READ,
+    BT_COPY_WRITE,
+    BT_COUNT,
+  };
+
+  enum TextureTarget
+  {
+    TT_2D,
+    TT_BUFFER,
+    TT_COUNT,
+  };
+
+  enum Capability
+  {
+    CAP_BLEND,
+    CAP_DEPTH_TEST,
+    CAP_CULL_FACE,
+    CAP_COUNT,
+  };
+
+  static unsigned int program;
+  static unsigned int vertexArray;
+  static unsigned int buffers[BT_COUNT];
+  static unsigned int uniformBindings[MAX_UNIFORM_BINDINGS];
+
+  // O element array buffer faz parte do estado do VAO, então é guardado por VAO
+  static std::unordered_map<unsigned int, unsigned int> elementBuffers;
+
+  static unsigned int activeTexture;
+  static unsigned int textures[MAX_TEXTURE_UNITS][TT_COUNT];
+
+  static unsigned int capabilities[CAP_COUNT];
+  static unsigned int blendSource;
+  static unsigned int blendDestination;
+  static unsigned int polygonMode;
+
+  static GLStateStats stats;
+
+  // Atualiza o valor guardado e retorna se a chamada precisa ser enviada ao driver
+  static bool Update(unsigned int &cached, unsigned int value);
+
+  static int GetBufferTarget(unsigned int target);
+  static int GetTextureTarget(unsigned int target);
+  static int GetCapability(unsigned int capability);
+
+  static void SetActiveTexture(unsigned int unit);
+
+public:
+  // Esquece todo o estado guardado, por exemplo depois de código que chama o OpenGL diretamente
+  static void Invalidate();
+
+  static void UseProgram(unsigned int program);
+  static void BindVertexArray(unsigned int vertexArray);
+  static void BindBuffer(unsigned int target, unsigned int buffer);
+  static void BindBufferBase(unsigned int target, unsigned int index, unsigned int buffer);
+  static void BindTexture(unsigned int unit, unsigned int target, unsigned int texture);
+
+  static void SetEnabled(unsigned int capability, bool isEnabled);
+  static void BlendFunc(unsigned int source, unsigned int destination);
+
+  static void PolygonMode(unsigned int mode);
+  static unsigned int GetPolygonMode();
+
+  // Apagam o objeto e esquecem as ligações dele, já que o OpenGL pode reutilizar o mesmo nome
+  static void DeleteProgram(unsigned int program);
+  static void DeleteVertexArray(unsigned int vertexArray);
+  static void DeleteBuffer(unsigned int buffer);
+  static void DeleteTexture(unsigned int texture);
+
+  static void ResetStats() { stats = GLStateStats(); }
+  static const GLStateStats &GetStats() { return stats; }
+};
+
+#endif
@@ -16,6 +16,7 @@ public:
   void Unbind() const;
 
   inline unsigned int GetCount() const { return m_Count; }
+  inline unsigned int GetRendererId() const { return m_RendererId; }
 };
 
 #endif
\ No newline at end of file
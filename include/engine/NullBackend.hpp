@@ -0,0 +1,48 @@
+#ifndef _NULLBACKEND_H
+#define _NULLBACKEND_H
+
+// Chamadas, recursos e desenhos registrados pelo backend nulo
+struct NullBackendStats
+{
+  // Desde o último ResetStats
+  long calls;
+  int drawCalls;
+  long drawnVertices; // Vértices ou índices enviados pelos desenhos
+  long uploadedBytes; // Enviados por glBufferData, glBufferSubData e glTexImage2D
+  long copiedBytes;   // Copiados entre buffers na GPU
+
+  // Recursos vivos
+  int buffers;
+  long bufferBytes;
+  int textures;
+  long textureBytes;
+  int vertexArrays;
+  int programs;
+};
+
+// Implementação do OpenGL 3.3 que não desenha nada e só registra as chamadas, os tamanhos dos buffers e os desenhos
+// É carregada no lugar do driver pelo mesmo loader do glad, então VertexBuffer, VertexArray, IndexBuffer, Texture,
+// Shader, Renderer e o GLState rodam sem alteração e sem contexto gráfico, por exemplo em máquinas de CI sem GPU
+// Só as funções usadas pelo engine são implementadas; as outras ficam nulas, como em um driver sem a função
+class NullBackend
+{
+private:
+  NullBackend() {}
+
+public:
+  // Carrega as funções do backend nulo no glad, no lugar de Window::Init
+  static bool Load();
+
+  // Loader do glad: retorna a implementação nula da função, ou nullptr
+  static void *GetProcAddress(const char *name);
+
+  // Zera os contadores de chamadas, desenhos e envios, mantendo a contagem dos recursos vivos
+  static void ResetStats();
+
+  static const NullBackendStats &GetStats();
+
+  // Tamanho atual do buffer, em bytes
+  static long GetBufferSize(unsigned int buffer);
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef _RECORDINGBACKEND_H
+#define _RECORDINGBACKEND_H
+
+#include <vector>
+
+#include "engine/RenderBackend.hpp"
+
+enum RecordedCommandType
+{
+  RC_USE_PROGRAM,
+  RC_BIND_VERTEX_ARRAY,
+  RC_BIND_INDEX_BUFFER,
+  RC_BIND_TEXTURE,
+  RC_SET_ENABLED,
+  RC_BLEND_FUNC,
+  RC_POLYGON_MODE,
+  RC_SET_UNIFORM,
+  RC_DRAW,
+  RC_COUNT,
+};
+
+// Comando gravado com os seus argumentos inteiros; uniforms de matriz só gravam a localização
+struct RecordedCommand
+{
+  RecordedCommandType type;
+  unsigned int arguments[3];
+};
+
+// Backend que não desenha nada e só grava os comandos recebidos, para inspecionar a execução de uma fila sem contexto OpenGL
+class RecordingBackend : public RenderBackend
+{
+private:
+  std::vector<RecordedCommand> m_Commands;
+  int m_Counts[RC_COUNT];
+
+  // Vértices ou índices enviados pelos comandos de desenho
+  long m_DrawnVertices;
+
+  void Record(RecordedCommandType type, unsigned int a = 0, unsigned int b = 0, unsigned int c = 0);
+
+public:
+  RecordingBackend();
+
+  void UseProgram(unsigned int program) override;
+  void BindVertexArray(unsigned int vertexArray) override;
+  void BindIndexBuffer(unsigned int buffer) override;
+  void BindTexture(unsigned int unit, unsigned int target, unsigned int texture) override;
+
+  void SetEnabled(unsigned int capability, bool isEnabled) override;
+  void BlendFunc(unsigned int source, unsigned int destination) override;
+  void PolygonMode(unsigned int mode) override;
+
+  void SetUniform(int location, int value) override;
+  void SetUniform(int location, const glm::mat4 &value) override;
+
+  void MultiDrawArrays(const int *firsts, const int *counts, int drawCount) override;
+  void DrawElements(int count, unsigned int offset) override;
+
+  void Clear();
+
+  const std::vector<RecordedCommand> &GetCommands() const { return m_Commands; }
+  int GetCount(RecordedCommandType type) const { return m_Counts[type]; }
+  long GetDrawnVertices() const { return m_DrawnVertices; }
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef _RENDERBACKEND_H
+#define _RENDERBACKEND_H
+
+#include <glm/mat4x4.hpp>
+
+// Comandos de estado e de desenho usados pela RenderQueue para executar os pacotes
+// Permite executar a mesma fila no OpenGL ou em um backend que só grava os comandos
+class RenderBackend
+{
+public:
+  virtual ~RenderBackend() {}
+
+  virtual void UseProgram(unsigned int program) = 0;
+  virtual void BindVertexArray(unsigned int vertexArray) = 0;
+  virtual void BindIndexBuffer(unsigned int buffer) = 0;
+  virtual void BindTexture(unsigned int unit, unsigned int target, unsigned int texture) = 0;
+
+  virtual void SetEnabled(unsigned int capability, bool isEnabled) = 0;
+  virtual void BlendFunc(unsigned int source, unsigned int destination) = 0;
+  virtual void PolygonMode(unsigned int mode) = 0;
+
+  virtual void SetUniform(int location, int value) = 0;
+  virtual void SetUniform(int location, const glm::mat4 &value) = 0;
+
+  virtual void MultiDrawArrays(const int *firsts, const int *counts, int drawCount) = 0;
+  virtual void DrawElements(int count, unsigned int offset) = 0;
+};
+
+// Executa os comandos no OpenGL, com as mudanças de estado filtradas pelo GLState
+class GLRenderBackend : public RenderBackend
+{
+public:
+  void UseProgram(unsigned int program) override;
+  void BindVertexArray(unsigned int vertexArray) override;
+  void BindIndexBuffer(unsigned int buffer) override;
+  void BindTexture(unsigned int unit, unsigned int target, unsigned int texture) override;
+
+  void SetEnabled(unsigned int capability, bool isEnabled) override;
+  void BlendFunc(unsigned int source, unsigned int destination) override;
+  void PolygonMode(unsigned int mode) override;
+
+  void SetUniform(int location, int value) override;
+  void SetUniform(int location, const glm::mat4 &value) override;
+
+  void MultiDrawArrays(const int *firsts, const int *counts, int drawCount) override;
+  void DrawElements(int count, unsigned int offset) override;
+};
+
+#endif
@@ -0,0 +1,166 @@
+#ifndef _RENDERQUEUE_H
+#define _RENDERQUEUE_H
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+
+#include "engine/RenderBackend.hpp"
+#include "engine/Shader.hpp"
+#include "engine/VertexArena.hpp"
+
+// Passes da fila, na ordem em que são executados
+enum DrawPass
+{
+  DP_OPAQUE,
+  DP_TRANSPARENT,
+  DP_INTERFACE,
+  DP_COUNT,
+};
+
+enum DrawCommandType
+{
+  DC_MULTI_ARRAYS, // Intervalos de uma DrawList, com um glMultiDrawArrays
+  DC_ELEMENTS,     // Triângulos indexados, com um glDrawElements
+};
+
+struct PacketTexture
+{
+  unsigned int unit;
+  unsigned int target;
+  unsigned int texture;
+};
+
+struct PacketUniform
+{
+  int location;
+  bool isMatrix;
+  int integer;
+  glm::mat4 matrix;
+};
+
+// Tudo que é preciso para executar um desenho: programa, VAO, texturas, uniforms próprios do desenho e o comando
+struct DrawPacket
+{
+  static const int MAX_TEXTURES = 4;
+  static const int MAX_UNIFORMS = 2;
+
+  unsigned int program = 0;
+  unsigned int vertexArray = 0;
+  unsigned int indexBuffer = 0;
+
+  PacketTexture textures[MAX_TEXTURES];
+  int textureCount = 0;
+
+  PacketUniform uniforms[MAX_UNIFORMS];
+  int uniformCount = 0;
+
+  DrawCommandType command = DC_ELEMENTS;
+
+  // A lista precisa continuar válida até a execução da fila
+  const DrawList *drawList = nullptr;
+
+  int elementCount = 0;
+  unsigned int elementOffset = 0; // Em bytes
+
+  void AddTexture(unsigned int unit, unsigned int target, unsigned int texture)
+  {
+    textures[textureCount++] = {unit, target, texture};
+  }
+
+  void AddUniform(Uniform<int> uniform, int value)
+  {
+    uniforms[uniformCount++] = {uniform.location, false, value, glm::mat4(1.0f)};
+  }
+
+  void AddUniform(Uniform<glm::mat4> uniform, const glm::mat4 &value)
+  {
+    uniforms[uniformCount++] = {uniform.location, true, 0, value};
+  }
+};
+
+// Trabalho da última execução da fila
+struct RenderQueueStats
+{
+  int packets;
+  int drawCalls;
+
+  // Chamadas de estado enviadas ao backend e evitadas por repetirem o estado do pacote anterior
+  int stateChanges;
+  int elidedStateChanges;
+
+  // Chamadas de estado enviadas em cada pass, incluindo o estado do próprio pass; somam stateChanges
+  int passStateChanges[DP_COUNT];
+};
+
+// Fila de desenhos do frame: os sistemas enviam pacotes em qualquer ordem e a fila os executa ordenados por uma chave de 64 bits
+//
+// Opaco:       pass (4) | programa (12) | textura (12) | VAO (12) | profundidade (24), da mais próxima para a mais distante
+// Transparente: pass (4) | profundidade invertida (24) | programa (12) | textura (12) | VAO (12), da mais distante para a mais próxima
+// Interface:   pass (4) | ordem de envio (24) | programa (12) | textura (12) | VAO (12)
+//
+// Os pacotes opacos ficam agrupados por estado, e os outros mantêm a ordem exigida pela mistura
+class RenderQueue
+{
+public:
+  struct SortItem
+  {
+    uint64_t key;
+    uint32_t packet;
+  };
+
+private:
+  static const int DEPTH_BITS = 24;
+  static const int ID_BITS = 12;
+
+  // Buffers reaproveitados entre frames
+  std::vector<DrawPacket> m_Packets;
+  std::vector<SortItem> m_Items;
+  std::vector<SortItem> m_SortBuffer;
+
+  uint32_t m_Sequence;
+
+  // Distância em que a profundidade quantizada satura
+  float m_FarDistance;
+
+  bool m_IsWireframe;
+
+  RenderQueueStats m_Stats;
+
+  // Radix sort LSD de 8 bits por dígito; dígitos iguais em todas as chaves são pulados
+  void Sort();
+
+  void SetPassState(RenderBackend &backend, DrawPass pass);
+
+public:
+  // A distância máxima deve ser a do far plane da câmera, para a precisão da profundidade cobrir o que é desenhado
+  RenderQueue(float farDistance);
+
+  // Profundidade quantizada em 24 bits, a partir da distância até a câmera
+  uint32_t QuantizeDepth(float distance) const;
+
+  static uint64_t MakeKey(DrawPass pass, unsigned int program, unsigned int texture, unsigned int vertexArray, uint32_t depth);
+
+  // Descarta os pacotes do frame anterior, mantendo a memória
+  void Clear();
+
+  void Submit(DrawPass pass, float distance, const DrawPacket &packet);
+
+  // Ordena os pacotes e os executa no backend, mudando só o estado que difere do pacote anterior
+  void Execute(RenderBackend &backend);
+
+  // Desenha os passes do mundo só com as arestas dos triângulos; a interface é sempre preenchida
+  void SetWireframe(bool isWireframe) { m_IsWireframe = isWireframe; }
+  bool IsWireframe() const { return m_IsWireframe; }
+
+  int GetPacketCount() const { return static_cast<int>(m_Packets.size()); }
+
+  // Pacotes na ordem da última execução
+  const std::vector<SortItem> &GetSortedItems() const { return m_Items; }
+  const DrawPacket &GetPacket(uint32_t index) const { return m_Packets[index]; }
+
+  const RenderQueueStats &GetStats() const { return m_Stats; }
+};
+
+#endif
@@ -12,9 +12,29 @@ struct ShaderProgramSource
   std::string FragmentSource;
 };
 
+// Conteúdo do bloco de uniforms Frame, compartilhado por todos os shaders e atualizado uma vez por frame
+// Segue o layout std140 do bloco, então só usa mat4 e vec4
+struct FrameConstants
+{
+  glm::mat4 view;
+  glm::mat4 projection;
+  glm::vec4 cameraPosition;
+};
+
+// Localização de um uniform resolvida uma única vez, com o tipo do valor que ele recebe
+template <typename T>
+struct Uniform
+{
+  int location = -1;
+};
+
 // Classe para load, compilação e uso de shaders
 class Shader
 {
+public:
+  // Ponto de ligação do bloco Frame em todos os shaders
+  static const unsigned int FRAME_BLOCK_BINDING = 0;
+
 private:
   unsigned int m_RendererId;
   std::string m_FilePath;
@@ -27,17 +47,33 @@ public:
   void Bind() const;
   void Unbind() const;
 
+  unsigned int GetRendererId() const { return m_RendererId; }
+
   void SetUniform1i(const std::string &name, int value);
   void SetUniform1f(const std::string &name, float value);
+  void SetUniform2f(const std::string &name, float v0, float v1);
   void SetUniform4f(const std::string &name, float v0, float v1, float v2, float v3);
   void SetUniformMat4f(const std::string &name, const glm::mat4 matrix);
 
+  // Procura o uniform pelo nome; deve ser chamado fora do loop de renderização, que só usa o handle
+  template <typename T>
+  Uniform<T> GetUniform(const std::string &name) { return {GetUniformLocation(name)}; }
+
+  void SetUniform(Uniform<int> uniform, int value);
+  void SetUniform(Uniform<float> uniform, float value);
+  void SetUniform(Uniform<glm::vec2> uniform, glm::vec2 value);
+  void SetUniform(Uniform<glm::vec4> uniform, glm::vec4 value);
+  void SetUniform(Uniform<glm::mat4> uniform, const glm::mat4 &value);
+
 private:
   ShaderProgramSource ParseShader(const std::string &filePath);
 
   unsigned int CompileShader(unsigned int type, const std::string &source);
   unsigned int CreateShader(const std::string &vertexShader, const std::string &fragmentShader);
 
+  // Preenche o cache com as localizações de todos os uniforms ativos e liga o bloco Frame
+  void ResolveUniforms();
+
   int GetUniformLocation(const std::string &name);
 };
 
@@ -17,7 +17,9 @@ public:
   ~Texture();
 
   void Bind(unsigned int slot = 0) const;
-  void Unbind() const;
+  void Unbind(unsigned int slot = 0) const;
+
+  inline unsigned int GetRendererId() const { return m_RendererId; }
 
   inline int GetWidth() const { return m_Width; }
   inline int GetHeight() const { return m_Height; }
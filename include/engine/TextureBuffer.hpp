@@ -0,0 +1,26 @@
+#ifndef _TEXTUREBUFFER_H
+#define _TEXTUREBUFFER_H
+
+// Classe para gerenciamento de buffer texture, um buffer lido no shader com texelFetch
+class TextureBuffer
+{
+private:
+  unsigned int m_BufferId;
+  unsigned int m_TextureId;
+
+public:
+  // internalFormat é o formato de cada texel, por exemplo GL_RG32I
+  TextureBuffer(unsigned int internalFormat);
+  ~TextureBuffer();
+
+  // Realoca o buffer com o novo conteúdo
+  void SetData(const void *data, unsigned int size);
+  void SetSubData(const void *data, unsigned int offset, unsigned int size);
+
+  void Bind(unsigned int slot = 0) const;
+  void Unbind(unsigned int slot = 0) const;
+
+  unsigned int GetTextureId() const { return m_TextureId; }
+};
+
+#endif
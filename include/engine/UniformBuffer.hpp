@@ -0,0 +1,22 @@
+#ifndef _UNIFORMBUFFER_H
+#define _UNIFORMBUFFER_H
+
+// Classe para gerenciamento de uniform buffer, um bloco de uniforms compartilhado por vários shaders
+class UniformBuffer
+{
+private:
+  unsigned int m_RendererId;
+  unsigned int m_Size;
+
+public:
+  UniformBuffer(unsigned int size);
+  ~UniformBuffer();
+
+  // Substitui todo o conteúdo do buffer, sem realocá-lo
+  void SetData(const void *data);
+
+  // Liga o buffer ao ponto de ligação usado pelos blocos de uniforms dos shaders
+  void BindBase(unsigned int binding) const;
+};
+
+#endif
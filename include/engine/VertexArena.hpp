@@ -0,0 +1,112 @@
+#ifndef _VERTEXARENA_H
+#define _VERTEXARENA_H
+
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "core/BufferAllocator.hpp"
+
+#include "engine/TextureBuffer.hpp"
+#include "engine/VertexArray.hpp"
+#include "engine/VertexBuffer.hpp"
+#include "engine/VertexBufferLayout.hpp"
+
+// Intervalos de vértices da arena desenhados por um único glMultiDrawArrays
+struct DrawList
+{
+  std::vector<int> firsts;
+  std::vector<int> counts;
+
+  void Add(int first, int count)
+  {
+    firsts.push_back(first);
+    counts.push_back(count);
+  }
+
+  void Clear()
+  {
+    firsts.clear();
+    counts.clear();
+  }
+
+  int GetSize() const { return static_cast<int>(firsts.size()); }
+};
+
+// Ocupação da arena, em vértices
+struct VertexArenaStats
+{
+  int capacity;
+  int allocated; // Páginas reservadas
+  int vertices;  // Vértices realmente usados dentro das páginas
+  int allocations;
+  int freeBlocks;
+  int largestFreeBlock;
+  float fragmentation;
+  int failedAllocations; // Meshes que não couberam nem na arena de tamanho máximo, desde a criação
+};
+
+// Um único vertex buffer e vertex array compartilhados pelas meshes de todos os chunks
+// O buffer é dividido em páginas de PAGE_VERTICES vértices, sub-alocadas pelo BufferAllocator, e cada página guarda
+// em uma buffer texture a origem horizontal da mesh dona dela, lida no shader por gl_VertexID / PAGE_VERTICES
+// Assim todos os chunks visíveis são desenhados com um glMultiDrawArrays, sem trocar de VAO nem de uniform
+class VertexArena
+{
+public:
+  static const int PAGE_VERTICES = 64;
+
+  // Tamanho mínimo de uma buffer texture garantido pelo OpenGL 3.3, em texels
+  static const int MAX_PAGES = 65536;
+
+private:
+  VertexBufferLayout m_Layout;
+  unsigned int m_VertexSize;
+
+  VertexArray *m_VertexArray;
+  VertexBuffer *m_VertexBuffer;
+
+  BufferAllocator m_Allocator;
+
+  // Origem de cada página, com uma cópia na CPU para realocar e desfragmentar a buffer texture
+  TextureBuffer *m_PageOrigins;
+  std::vector<glm::ivec2> m_PageOriginData;
+
+  // Vértices usados por alocação, indexados pelo handle
+  std::vector<int> m_VertexCounts;
+  int m_VertexCount;
+
+  int m_FailedAllocations;
+
+  // Realoca os buffers com mais páginas, copiando o conteúdo na GPU
+  void Resize(int pages);
+
+  static int GetPageCount(int vertexCount) { return (vertexCount + PAGE_VERTICES - 1) / PAGE_VERTICES; }
+
+public:
+  VertexArena(const VertexBufferLayout &layout, unsigned int vertexSize, int initialPages);
+  ~VertexArena();
+
+  // Copia os vértices para a arena e retorna o handle da alocação, ou BufferAllocator::INVALID se eles não cabem
+  // Desfragmenta ou aumenta a arena quando não há um bloco livre grande o suficiente
+  int Allocate(const void *vertices, int vertexCount, glm::ivec2 origin);
+  void Free(int handle);
+
+  // Primeiro vértice da alocação no buffer, que muda quando a arena é desfragmentada
+  int GetFirst(int handle) const { return m_Allocator.GetOffset(handle) * PAGE_VERTICES; }
+
+  // Junta as alocações no início do buffer
+  void Defragment();
+
+  // Muitos buracos pequenos ocupando uma parte considerável da arena
+  bool IsFragmented() const;
+
+  VertexArenaStats GetStats() const;
+
+  // Vertex array de todas as alocações, desenhadas com os intervalos de uma DrawList
+  unsigned int GetVertexArrayId() const { return m_VertexArray->GetRendererId(); }
+
+  // Buffer texture com a origem de cada página
+  unsigned int GetPageOriginsId() const { return m_PageOrigins->GetTextureId(); }
+};
+
+#endif
@@ -19,6 +19,8 @@ public:
 
   void Bind() const;
   void Unbind() const;
+
+  unsigned int GetRendererId() const { return m_RendererId; }
 };
 
 #endif
@@ -6,11 +6,22 @@ class VertexBuffer
 {
 private:
   unsigned int m_RendererId;
+  unsigned int m_Usage;
 
 public:
-  VertexBuffer(const void *data, unsigned int size);
+  // Buffers dinâmicos são reescritos com frequência pela CPU
+  VertexBuffer(const void *data, unsigned int size, bool isDynamic = false);
   ~VertexBuffer();
 
+  // Substitui o conteúdo do buffer, mantendo o mesmo objeto de GPU
+  void SetData(const void *data, unsigned int size);
+
+  // Atualiza um trecho do buffer sem realocá-lo
+  void SetSubData(const void *data, unsigned int offset, unsigned int size);
+
+  // Copia um trecho de outro buffer na GPU, sem passar pela CPU
+  void CopySubData(const VertexBuffer &source, unsigned int readOffset, unsigned int writeOffset, unsigned int size);
+
   void Bind() const;
   void Unbind() const;
 };
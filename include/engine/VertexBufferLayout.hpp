@@ -19,6 +19,7 @@ struct VertexBufferElement
 	unsigned int type;
 	unsigned int count;
 	unsigned char normalized;
+	bool isInteger;
 
 	static unsigned int GetSizeOfType(unsigned int type)
 	{
@@ -51,6 +52,7 @@ public:
 	{
 		unsigned int glType;
 		unsigned char normalized;
+		bool isInteger = false;
 
 		switch (type)
 		{
@@ -59,9 +61,11 @@ public:
 			normalized = GL_FALSE;
 			break;
 
+		// Lido como inteiro no shader (uint), sem conversão para float
 		case LayoutType::LT_UINT:
 			glType = GL_UNSIGNED_INT;
 			normalized = GL_FALSE;
+			isInteger = true;
 			break;
 
 		case LayoutType::LT_UCHAR:
@@ -70,7 +74,7 @@ public:
 			break;
 		}
 
-		VertexBufferElement element = {glType, count, normalized};
+		VertexBufferElement element = {glType, count, normalized, isInteger};
 		m_Elements.push_back(element);
 		m_Stride += count * VertexBufferElement::GetSizeOfType(glType);
 	}
@@ -73,6 +73,12 @@ public:
     m_FOV = fov;
   }
 
+  // Negativo, como o near plane, já que a câmera olha para -z
+  float GetFarplane() const
+  {
+    return m_Farplane;
+  }
+
   bool IsFreeCamera() const
   {
     return m_UseFreeCamera;
@@ -36,6 +36,7 @@ private:
   const float CHARACTER_HEIGHT = 1.8f;
 
   Shader *m_Shader;
+  Uniform<glm::mat4> m_TransformUniform;
 
   VertexArray *m_VAO;
   VertexBuffer *m_VBO;
@@ -82,7 +83,7 @@ public:
 
   void Update(Camera *camera, World *world);
 
-  void Draw(Camera *camera, glm::mat4 view, glm::mat4 projection);
+  void Draw(RenderQueue &queue, Camera *camera);
 
   void OnClick(int button, int action, int mods);
   void OnKeypress(int key, int scancode, int action, int mods);
@@ -9,13 +9,34 @@
 #include "engine/VertexBuffer.hpp"
 #include "engine/VertexBufferLayout.hpp"
 #include "engine/IndexBuffer.hpp"
-#include "engine/Renderer.hpp"
+#include "engine/RenderQueue.hpp"
 
 #include "entity/Window.hpp"
 
 const int UI_HOTBAR_SIZE = 9;
 
+// Texturas da interface, na ordem das unidades de textura em que são ligadas
+enum UITexture
+{
+  UIT_ATLAS,
+  UIT_CROSSHAIR,
+  UIT_HOTBAR,
+  UIT_HOTBAR_SELECTOR,
+};
+
+// Retângulos da interface, na ordem em que são desenhados
+enum UIQuad
+{
+  UIQ_CROSSHAIR,
+  UIQ_HOTBAR,
+  UIQ_HOTBAR_SELECTOR,
+  UIQ_HOTBAR_ICONS,
+  UIQ_COUNT = UIQ_HOTBAR_ICONS + UI_HOTBAR_SIZE,
+};
+
 // Classe para gerenciamento e renderização da interface de usuário
+// A geometria de toda a interface fica em um único vertex buffer, reconstruído só quando a hotbar ou a janela mudam,
+// e é desenhada com uma única chamada
 class UserInterface
 {
 private:
@@ -41,17 +62,51 @@ private:
   static const float hotbarIconWidth;
   static const float hotbarIconHeight;
 
-  static std::array<float, 5 * 4 * UI_HOTBAR_SIZE> hotbarVertices;
-  static std::array<unsigned int, 6 * UI_HOTBAR_SIZE> hotbarIndices;
+  // Posição, coordenadas de textura e textura de cada vértice
+  static const int vertexSize = 6;
+
+  static std::array<float, vertexSize * 4 * UIQ_COUNT> vertices;
+
+  // Coordenadas no atlas do ícone de cada posição da hotbar, vazias até a posição receber um item
+  static std::array<std::array<glm::vec2, 4>, UI_HOTBAR_SIZE> hotbarIconCoords;
+  static std::array<bool, UI_HOTBAR_SIZE> hotbarIconIsSet;
+
+  static Texture *crosshairTexture;
+  static Texture *hotbarTexture;
+  static Texture *hotbarSelectorTexture;
+
+  static VertexArray *vertexArray;
+  static VertexBuffer *vertexBuffer;
+  static IndexBuffer *indexBuffer;
+
+  // Estado usado na última reconstrução da geometria
+  static bool isDirty;
+  static int builtWidth;
+  static int builtHeight;
+  static int builtHotbarPosition;
+
+  static int geometryBuilds;
+
+  static void SetQuad(int quad, const std::array<glm::vec2, 4> &positions, const std::array<glm::vec2, 4> &textureCoords, UITexture texture);
+  static void SetElementQuad(int quad, UITexture texture, float elementWidth, float elementHeight, float centerX, float centerY);
+
+  static void BuildGeometry(int hotbarPosition);
 
 public:
-  static void UpdateHotbarPosition(int position, std::array<glm::vec2, 4> textureCoords);
+  // Carrega as texturas e cria os buffers da interface, depois da criação do contexto OpenGL
+  // Os samplers do shader da interface apontam para unidades fixas, então são definidos só aqui
+  static void Init(Shader *shader);
 
-  static void DrawUIElement(Shader *shader, std::string texturePath, int elementWidth, int elementHeight, float centerX, float centerY);
+  // Libera os recursos de GPU, antes da destruição do contexto
+  static void Terminate();
+
+  static void UpdateHotbarPosition(int position, std::array<glm::vec2, 4> textureCoords);
 
-  static void DrawHotbarIcons(Shader *shader);
+  // O estado de desenho da interface (sem depth test, com mistura e sempre preenchida) é definido pelo pass da fila
+  static void DrawUI(RenderQueue &queue, Shader *shader, Texture *atlas, int hotbarPosition);
 
-  static void DrawUI(Shader *shader, Texture *atlas, int hotbarPosition);
+  // Quantas vezes a geometria da interface foi reconstruída
+  static int GetGeometryBuilds() { return geometryBuilds; }
 };
 
-#endif
\ No newline at end of file
+#endif
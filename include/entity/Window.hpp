@@ -20,6 +20,9 @@ private:
 
 public:
   static bool Init(bool fullscreen = true);
+
+  // Define só o tamanho da tela, sem criar janela nem contexto, para rodar com o backend nulo
+  static void InitHeadless(int width, int height);
   static void Tick();
   static void EndFrame();
   static void Terminate();
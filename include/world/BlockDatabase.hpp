@@ -2,6 +2,8 @@
 #define _BLOCKDATABASE_H
 
 #include <array>
+#include <cstdint>
+#include <cstring>
 #include <string>
 
 #include <glm/glm.hpp>
@@ -119,78 +121,78 @@ struct TextureInfo
   int bottom;
 };
 
-const TextureInfo AIR_TEXTURE = {-1, -1, -1, -1};
-const TextureInfo STONE_TEXTURE = {STONE_SIDE, STONE_SIDE, STONE_SIDE, STONE_SIDE};
-const TextureInfo ANDESITE_TEXTURE = {ANDESITE_SIDE, ANDESITE_SIDE, ANDESITE_SIDE, ANDESITE_SIDE};
-const TextureInfo DIRT_TEXTURE = {DIRT_SIDE, DIRT_SIDE, DIRT_SIDE, DIRT_SIDE};
-
-const TextureInfo GRASS_TEXTURE = {GRASS_SIDE, GRASS_SIDE, GRASS_TOP, DIRT_SIDE};
-const TextureInfo SNOW_TEXTURE = {SNOW_SIDE, SNOW_SIDE, SNOW_SIDE, DIRT_SIDE};
-const TextureInfo PODZIL_TEXTURE = {PODZIL_SIDE, PODZIL_SIDE, PODZIL_TOP, DIRT_SIDE};
-
-const TextureInfo OAK_PLANK_TEXTURE = {OAK_PLANK_SIDE, OAK_PLANK_SIDE, OAK_PLANK_SIDE, OAK_PLANK_SIDE};
-const TextureInfo SPRUCE_PLANK_TEXTURE = {SPRUCE_PLANK_SIDE, SPRUCE_PLANK_SIDE, SPRUCE_PLANK_SIDE, SPRUCE_PLANK_SIDE};
-const TextureInfo BIRCH_PLANK_TEXTURE = {BIRCH_PLANK_SIDE, BIRCH_PLANK_SIDE, BIRCH_PLANK_SIDE, BIRCH_PLANK_SIDE};
-const TextureInfo JUNGLE_PLANK_TEXTURE = {JUNGLE_PLANK_SIDE, JUNGLE_PLANK_SIDE, JUNGLE_PLANK_SIDE, JUNGLE_PLANK_SIDE};
-const TextureInfo ACACIA_PLANK_TEXTURE = {ACACIA_PLANK_SIDE, ACACIA_PLANK_SIDE, ACACIA_PLANK_SIDE, ACACIA_PLANK_SIDE};
-const TextureInfo DARK_OAK_PLANK_TEXTURE = {DARK_OAK_PLANK_SIDE, DARK_OAK_PLANK_SIDE, DARK_OAK_PLANK_SIDE, DARK_OAK_PLANK_SIDE};
-
-const TextureInfo OAK_LOG_TEXTURE = {OAK_LOG_SIDE, OAK_LOG_SIDE, OAK_LOG_TOP, OAK_LOG_TOP};
-const TextureInfo SPRUCE_LOG_TEXTURE = {SPRUCE_LOG_SIDE, SPRUCE_LOG_SIDE, SPRUCE_LOG_TOP, SPRUCE_LOG_TOP};
-const TextureInfo BIRCH_LOG_TEXTURE = {BIRCH_LOG_SIDE, BIRCH_LOG_SIDE, BIRCH_LOG_TOP, BIRCH_LOG_TOP};
-const TextureInfo JUNGLE_LOG_TEXTURE = {JUNGLE_LOG_SIDE, JUNGLE_LOG_SIDE, JUNGLE_LOG_TOP, JUNGLE_LOG_TOP};
-const TextureInfo ACACIA_LOG_TEXTURE = {ACACIA_LOG_SIDE, ACACIA_LOG_SIDE, ACACIA_LOG_TOP, ACACIA_LOG_TOP};
-const TextureInfo DARK_OAK_LOG_TEXTURE = {DARK_OAK_LOG_SIDE, DARK_OAK_LOG_SIDE, DARK_OAK_LOG_TOP, DARK_OAK_LOG_TOP};
-
-const TextureInfo COBBLESTONE_TEXTURE = {COBBLESTONE_SIDE, COBBLESTONE_SIDE, COBBLESTONE_SIDE, COBBLESTONE_SIDE};
-const TextureInfo MOSSY_COBBLESTONE_TEXUTRE = {MOSSY_COBBLESTONE_SIDE, MOSSY_COBBLESTONE_SIDE, MOSSY_COBBLESTONE_SIDE, MOSSY_COBBLESTONE_SIDE};
-
-const TextureInfo SAND_TEXTURE = {SAND_SIDE, SAND_SIDE, SAND_SIDE, SAND_SIDE};
-const TextureInfo RED_SAND_TEXTURE = {RED_SAND_SIDE, RED_SAND_SIDE, RED_SAND_SIDE, RED_SAND_SIDE};
-const TextureInfo GRAVEL_TEXTURE = {GRAVEL_SIDE, GRAVEL_SIDE, GRAVEL_SIDE, GRAVEL_SIDE};
-
-const TextureInfo COAL_ORE_TEXTURE = {COAL_ORE_SIDE, COAL_ORE_SIDE, COAL_ORE_SIDE, COAL_ORE_SIDE};
-const TextureInfo IRON_ORE_TEXTURE = {IRON_ORE_SIDE, IRON_ORE_SIDE, IRON_ORE_SIDE, IRON_ORE_SIDE};
-const TextureInfo LAPIS_ORE_TEXTURE = {LAPIS_ORE_SIDE, LAPIS_ORE_SIDE, LAPIS_ORE_SIDE, LAPIS_ORE_SIDE};
-const TextureInfo EMERALD_ORE_TEXTURE = {EMERALD_ORE_SIDE, EMERALD_ORE_SIDE, EMERALD_ORE_SIDE, EMERALD_ORE_SIDE};
-const TextureInfo GOLD_ORE_TEXTURE = {GOLD_ORE_SIDE, GOLD_ORE_SIDE, GOLD_ORE_SIDE, GOLD_ORE_SIDE};
-const TextureInfo REDSTONE_ORE_TEXTURE = {REDSTONE_ORE_SIDE, REDSTONE_ORE_SIDE, REDSTONE_ORE_SIDE, REDSTONE_ORE_SIDE};
-const TextureInfo DIAMOND_ORE_TEXTURE = {DIAMOND_ORE_SIDE, DIAMOND_ORE_SIDE, DIAMOND_ORE_SIDE, DIAMOND_ORE_SIDE};
-const TextureInfo QUARTZ_ORE_TEXTURE = {QUARTZ_ORE_SIDE, QUARTZ_ORE_SIDE, QUARTZ_ORE_SIDE, QUARTZ_ORE_SIDE};
-
-const TextureInfo COAL_BLOCK_TEXTURE = {COAL_BLOCK_SIDE, COAL_BLOCK_SIDE, COAL_BLOCK_SIDE, COAL_BLOCK_SIDE};
-const TextureInfo IRON_BLOCK_TEXTURE = {IRON_BLOCK_SIDE, IRON_BLOCK_SIDE, IRON_BLOCK_SIDE, IRON_BLOCK_SIDE};
-const TextureInfo LAPIS_BLOCK_TEXTURE = {LAPIS_BLOCK_SIDE, LAPIS_BLOCK_SIDE, LAPIS_BLOCK_SIDE, LAPIS_BLOCK_SIDE};
-const TextureInfo EMERALD_BLOCK_TEXTURE = {EMERALD_BLOCK_SIDE, EMERALD_BLOCK_SIDE, EMERALD_BLOCK_SIDE, EMERALD_BLOCK_SIDE};
-const TextureInfo GOLD_BLOCK_TEXTURE = {GOLD_BLOCK_SIDE, GOLD_BLOCK_SIDE, GOLD_BLOCK_SIDE, GOLD_BLOCK_SIDE};
-const TextureInfo REDSTONE_BLOCK_TEXTURE = {REDSTONE_BLOCK_SIDE, REDSTONE_BLOCK_SIDE, REDSTONE_BLOCK_SIDE, REDSTONE_BLOCK_SIDE};
-const TextureInfo DIAMOND_BLOCK_TEXTURE = {DIAMOND_BLOCK_SIDE, DIAMOND_BLOCK_SIDE, DIAMOND_BLOCK_SIDE, DIAMOND_BLOCK_SIDE};
-
-const TextureInfo OAK_LEAVES_TEXTURE = {OAK_LEAVES_SIDE, OAK_LEAVES_SIDE, OAK_LEAVES_TOP, OAK_LEAVES_TOP};
-const TextureInfo SPRUCE_LEAVES_TEXTURE = {SPRUCE_LEAVES_SIDE, SPRUCE_LEAVES_SIDE, SPRUCE_LEAVES_TOP, SPRUCE_LEAVES_TOP};
-const TextureInfo BIRCH_LEAVES_TEXTURE = {BIRCH_LEAVES_SIDE, BIRCH_LEAVES_SIDE, BIRCH_LEAVES_TOP, BIRCH_LEAVES_TOP};
-const TextureInfo JUNGLE_LEAVES_TEXTURE = {JUNGLE_LEAVES_SIDE, JUNGLE_LEAVES_SIDE, JUNGLE_LEAVES_TOP, JUNGLE_LEAVES_TOP};
-const TextureInfo ACACIA_LEAVES_TEXTURE = {ACACIA_LEAVES_SIDE, ACACIA_LEAVES_SIDE, ACACIA_LEAVES_TOP, ACACIA_LEAVES_TOP};
-const TextureInfo DARK_OAK_LEAVES_TEXTURE = {DARK_OAK_LEAVES_SIDE, DARK_OAK_LEAVES_SIDE, DARK_OAK_LEAVES_TOP, DARK_OAK_LEAVES_TOP};
-
-const TextureInfo BEDROCK_TEXTURE = {BEDROCK_SIDE, BEDROCK_SIDE, BEDROCK_SIDE, BEDROCK_SIDE};
-const TextureInfo OBSIDIAN_TEXTURE = {OBSIDIAN_SIDE, OBSIDIAN_SIDE, OBSIDIAN_SIDE, OBSIDIAN_SIDE};
-
-const TextureInfo STONE_BRICK_TEXTURE = {STONE_BRICK_SIDE, STONE_BRICK_SIDE, STONE_BRICK_SIDE, STONE_BRICK_SIDE};
-const TextureInfo MOSSY_STONE_BRICK_TEXTURE = {MOSSY_STONE_BRICK_SIDE, MOSSY_STONE_BRICK_SIDE, MOSSY_STONE_BRICK_SIDE, MOSSY_STONE_BRICK_SIDE};
-const TextureInfo CRACKED_STONE_BRICK_TEXTURE = {CRACKED_STONE_BRICK_SIDE, CRACKED_STONE_BRICK_SIDE, CRACKED_STONE_BRICK_SIDE, CRACKED_STONE_BRICK_SIDE};
-const TextureInfo CHISELED_STONE_BRICK_TEXTURE = {CHISELED_STONE_BRICK_SIDE, CHISELED_STONE_BRICK_SIDE, CHISELED_STONE_BRICK_SIDE, CHISELED_STONE_BRICK_SIDE};
-
-const TextureInfo CRAFTING_TABLE_TEXTURE = {CRAFTING_TABLE_FACE, CRAFTING_TABLE_SIDE, CRAFTING_TABLE_TOP, OAK_PLANK_SIDE};
-const TextureInfo FURNACE_TEXTURE = {FURNACE_FACE, FURNACE_SIDE, FURNACE_TOP, FURNACE_TOP};
-
-const TextureInfo WATER_TEXTURE = {WATER_SIDE, WATER_SIDE, WATER_TOP, WATER_SIDE};
-
-const TextureInfo GLASS_TEXTURE = {GLASS_SIDE, GLASS_SIDE, GLASS_SIDE, GLASS_SIDE};
+constexpr TextureInfo AIR_TEXTURE = {-1, -1, -1, -1};
+constexpr TextureInfo STONE_TEXTURE = {STONE_SIDE, STONE_SIDE, STONE_SIDE, STONE_SIDE};
+constexpr TextureInfo ANDESITE_TEXTURE = {ANDESITE_SIDE, ANDESITE_SIDE, ANDESITE_SIDE, ANDESITE_SIDE};
+constexpr TextureInfo DIRT_TEXTURE = {DIRT_SIDE, DIRT_SIDE, DIRT_SIDE, DIRT_SIDE};
+
+constexpr TextureInfo GRASS_TEXTURE = {GRASS_SIDE, GRASS_SIDE, GRASS_TOP, DIRT_SIDE};
+constexpr TextureInfo SNOW_TEXTURE = {SNOW_SIDE, SNOW_SIDE, SNOW_SIDE, DIRT_SIDE};
+constexpr TextureInfo PODZIL_TEXTURE = {PODZIL_SIDE, PODZIL_SIDE, PODZIL_TOP, DIRT_SIDE};
+
+constexpr TextureInfo OAK_PLANK_TEXTURE = {OAK_PLANK_SIDE, OAK_PLANK_SIDE, OAK_PLANK_SIDE, OAK_PLANK_SIDE};
+constexpr TextureInfo SPRUCE_PLANK_TEXTURE = {SPRUCE_PLANK_SIDE, SPRUCE_PLANK_SIDE, SPRUCE_PLANK_SIDE, SPRUCE_PLANK_SIDE};
+constexpr TextureInfo BIRCH_PLANK_TEXTURE = {BIRCH_PLANK_SIDE, BIRCH_PLANK_SIDE, BIRCH_PLANK_SIDE, BIRCH_PLANK_SIDE};
+constexpr TextureInfo JUNGLE_PLANK_TEXTURE = {JUNGLE_PLANK_SIDE, JUNGLE_PLANK_SIDE, JUNGLE_PLANK_SIDE, JUNGLE_PLANK_SIDE};
+constexpr TextureInfo ACACIA_PLANK_TEXTURE = {ACACIA_PLANK_SIDE, ACACIA_PLANK_SIDE, ACACIA_PLANK_SIDE, ACACIA_PLANK_SIDE};
+constexpr TextureInfo DARK_OAK_PLANK_TEXTURE = {DARK_OAK_PLANK_SIDE, DARK_OAK_PLANK_SIDE, DARK_OAK_PLANK_SIDE, DARK_OAK_PLANK_SIDE};
+
+constexpr TextureInfo OAK_LOG_TEXTURE = {OAK_LOG_SIDE, OAK_LOG_SIDE, OAK_LOG_TOP, OAK_LOG_TOP};
+constexpr TextureInfo SPRUCE_LOG_TEXTURE = {SPRUCE_LOG_SIDE, SPRUCE_LOG_SIDE, SPRUCE_LOG_TOP, SPRUCE_LOG_TOP};
+constexpr TextureInfo BIRCH_LOG_TEXTURE = {BIRCH_LOG_SIDE, BIRCH_LOG_SIDE, BIRCH_LOG_TOP, BIRCH_LOG_TOP};
+constexpr TextureInfo JUNGLE_LOG_TEXTURE = {JUNGLE_LOG_SIDE, JUNGLE_LOG_SIDE, JUNGLE_LOG_TOP, JUNGLE_LOG_TOP};
+constexpr TextureInfo ACACIA_LOG_TEXTURE = {ACACIA_LOG_SIDE, ACACIA_LOG_SIDE, ACACIA_LOG_TOP, ACACIA_LOG_TOP};
+constexpr TextureInfo DARK_OAK_LOG_TEXTURE = {DARK_OAK_LOG_SIDE, DARK_OAK_LOG_SIDE, DARK_OAK_LOG_TOP, DARK_OAK_LOG_TOP};
+
+constexpr TextureInfo COBBLESTONE_TEXTURE = {COBBLESTONE_SIDE, COBBLESTONE_SIDE, COBBLESTONE_SIDE, COBBLESTONE_SIDE};
+constexpr TextureInfo MOSSY_COBBLESTONE_TEXUTRE = {MOSSY_COBBLESTONE_SIDE, MOSSY_COBBLESTONE_SIDE, MOSSY_COBBLESTONE_SIDE, MOSSY_COBBLESTONE_SIDE};
+
+constexpr TextureInfo SAND_TEXTURE = {SAND_SIDE, SAND_SIDE, SAND_SIDE, SAND_SIDE};
+constexpr TextureInfo RED_SAND_TEXTURE = {RED_SAND_SIDE, RED_SAND_SIDE, RED_SAND_SIDE, RED_SAND_SIDE};
+constexpr TextureInfo GRAVEL_TEXTURE = {GRAVEL_SIDE, GRAVEL_SIDE, GRAVEL_SIDE, GRAVEL_SIDE};
+
+constexpr TextureInfo COAL_ORE_TEXTURE = {COAL_ORE_SIDE, COAL_ORE_SIDE, COAL_ORE_SIDE, COAL_ORE_SIDE};
+constexpr TextureInfo IRON_ORE_TEXTURE = {IRON_ORE_SIDE, IRON_ORE_SIDE, IRON_ORE_SIDE, IRON_ORE_SIDE};
+constexpr TextureInfo LAPIS_ORE_TEXTURE = {LAPIS_ORE_SIDE, LAPIS_ORE_SIDE, LAPIS_ORE_SIDE, LAPIS_ORE_SIDE};
+constexpr TextureInfo EMERALD_ORE_TEXTURE = {EMERALD_ORE_SIDE, EMERALD_ORE_SIDE, EMERALD_ORE_SIDE, EMERALD_ORE_SIDE};
+constexpr TextureInfo GOLD_ORE_TEXTURE = {GOLD_ORE_SIDE, GOLD_ORE_SIDE, GOLD_ORE_SIDE, GOLD_ORE_SIDE};
+constexpr TextureInfo REDSTONE_ORE_TEXTURE = {REDSTONE_ORE_SIDE, REDSTONE_ORE_SIDE, REDSTONE_ORE_SIDE, REDSTONE_ORE_SIDE};
+constexpr TextureInfo DIAMOND_ORE_TEXTURE = {DIAMOND_ORE_SIDE, DIAMOND_ORE_SIDE, DIAMOND_ORE_SIDE, DIAMOND_ORE_SIDE};
+constexpr TextureInfo QUARTZ_ORE_TEXTURE = {QUARTZ_ORE_SIDE, QUARTZ_ORE_SIDE, QUARTZ_ORE_SIDE, QUARTZ_ORE_SIDE};
+
+constexpr TextureInfo COAL_BLOCK_TEXTURE = {COAL_BLOCK_SIDE, COAL_BLOCK_SIDE, COAL_BLOCK_SIDE, COAL_BLOCK_SIDE};
+constexpr TextureInfo IRON_BLOCK_TEXTURE = {IRON_BLOCK_SIDE, IRON_BLOCK_SIDE, IRON_BLOCK_SIDE, IRON_BLOCK_SIDE};
+constexpr TextureInfo LAPIS_BLOCK_TEXTURE = {LAPIS_BLOCK_SIDE, LAPIS_BLOCK_SIDE, LAPIS_BLOCK_SIDE, LAPIS_BLOCK_SIDE};
+constexpr TextureInfo EMERALD_BLOCK_TEXTURE = {EMERALD_BLOCK_SIDE, EMERALD_BLOCK_SIDE, EMERALD_BLOCK_SIDE, EMERALD_BLOCK_SIDE};
+constexpr TextureInfo GOLD_BLOCK_TEXTURE = {GOLD_BLOCK_SIDE, GOLD_BLOCK_SIDE, GOLD_BLOCK_SIDE, GOLD_BLOCK_SIDE};
+constexpr TextureInfo REDSTONE_BLOCK_TEXTURE = {REDSTONE_BLOCK_SIDE, REDSTONE_BLOCK_SIDE, REDSTONE_BLOCK_SIDE, REDSTONE_BLOCK_SIDE};
+constexpr TextureInfo DIAMOND_BLOCK_TEXTURE = {DIAMOND_BLOCK_SIDE, DIAMOND_BLOCK_SIDE, DIAMOND_BLOCK_SIDE, DIAMOND_BLOCK_SIDE};
+
+constexpr TextureInfo OAK_LEAVES_TEXTURE = {OAK_LEAVES_SIDE, OAK_LEAVES_SIDE, OAK_LEAVES_TOP, OAK_LEAVES_TOP};
+constexpr TextureInfo SPRUCE_LEAVES_TEXTURE = {SPRUCE_LEAVES_SIDE, SPRUCE_LEAVES_SIDE, SPRUCE_LEAVES_TOP, SPRUCE_LEAVES_TOP};
+constexpr TextureInfo BIRCH_LEAVES_TEXTURE = {BIRCH_LEAVES_SIDE, BIRCH_LEAVES_SIDE, BIRCH_LEAVES_TOP, BIRCH_LEAVES_TOP};
+constexpr TextureInfo JUNGLE_LEAVES_TEXTURE = {JUNGLE_LEAVES_SIDE, JUNGLE_LEAVES_SIDE, JUNGLE_LEAVES_TOP, JUNGLE_LEAVES_TOP};
+constexpr TextureInfo ACACIA_LEAVES_TEXTURE = {ACACIA_LEAVES_SIDE, ACACIA_LEAVES_SIDE, ACACIA_LEAVES_TOP, ACACIA_LEAVES_TOP};
+constexpr TextureInfo DARK_OAK_LEAVES_TEXTURE = {DARK_OAK_LEAVES_SIDE, DARK_OAK_LEAVES_SIDE, DARK_OAK_LEAVES_TOP, DARK_OAK_LEAVES_TOP};
+
+constexpr TextureInfo BEDROCK_TEXTURE = {BEDROCK_SIDE, BEDROCK_SIDE, BEDROCK_SIDE, BEDROCK_SIDE};
+constexpr TextureInfo OBSIDIAN_TEXTURE = {OBSIDIAN_SIDE, OBSIDIAN_SIDE, OBSIDIAN_SIDE, OBSIDIAN_SIDE};
+
+constexpr TextureInfo STONE_BRICK_TEXTURE = {STONE_BRICK_SIDE, STONE_BRICK_SIDE, STONE_BRICK_SIDE, STONE_BRICK_SIDE};
+constexpr TextureInfo MOSSY_STONE_BRICK_TEXTURE = {MOSSY_STONE_BRICK_SIDE, MOSSY_STONE_BRICK_SIDE, MOSSY_STONE_BRICK_SIDE, MOSSY_STONE_BRICK_SIDE};
+constexpr TextureInfo CRACKED_STONE_BRICK_TEXTURE = {CRACKED_STONE_BRICK_SIDE, CRACKED_STONE_BRICK_SIDE, CRACKED_STONE_BRICK_SIDE, CRACKED_STONE_BRICK_SIDE};
+constexpr TextureInfo CHISELED_STONE_BRICK_TEXTURE = {CHISELED_STONE_BRICK_SIDE, CHISELED_STONE_BRICK_SIDE, CHISELED_STONE_BRICK_SIDE, CHISELED_STONE_BRICK_SIDE};
+
+constexpr TextureInfo CRAFTING_TABLE_TEXTURE = {CRAFTING_TABLE_FACE, CRAFTING_TABLE_SIDE, CRAFTING_TABLE_TOP, OAK_PLANK_SIDE};
+constexpr TextureInfo FURNACE_TEXTURE = {FURNACE_FACE, FURNACE_SIDE, FURNACE_TOP, FURNACE_TOP};
+
+constexpr TextureInfo WATER_TEXTURE = {WATER_SIDE, WATER_SIDE, WATER_TOP, WATER_SIDE};
+
+constexpr TextureInfo GLASS_TEXTURE = {GLASS_SIDE, GLASS_SIDE, GLASS_SIDE, GLASS_SIDE};
 
 struct BlockBaseInformation
 {
-  std::string blockId;
+  const char *blockId;
   TextureInfo textureReference;
   bool isOpaque;
   bool isSolid;
@@ -198,7 +200,7 @@ struct BlockBaseInformation
 
 struct BlockInformation
 {
-  std::string blockId;
+  const char *blockId;
   TextureInfo textureReference;
   std::array<glm::vec2, 36> textureCoordinates;
   bool isOpaque;
@@ -207,7 +209,7 @@ struct BlockInformation
 
 const int BLOCK_COUNT = 55;
 
-const BlockBaseInformation BLOCK_ATLAS[BLOCK_COUNT] = {
+constexpr BlockBaseInformation BLOCK_ATLAS[BLOCK_COUNT] = {
     {"air", AIR_TEXTURE, false, false},
     {"stone", STONE_TEXTURE, true, true},
     {"andesite", ANDESITE_TEXTURE, true, true},
@@ -320,21 +322,184 @@ const int CRAFTING_TABLE = 51;
 const int FURNACE = 52;
 const int WATER = 53;
 
+// Tabela de propriedades dos blocos em estrutura de arrays, toda calculada em tempo de compilação a partir de BLOCK_ATLAS
+namespace BlockTable
+{
+  const int HORIZONTAL_TEXTURE_COUNT = 32;
+  const int VERTICAL_TEXTURE_COUNT = 11;
+
+  static_assert(BLOCK_COUNT <= 64, "As propriedades dos blocos são guardadas em máscaras de 64 bits");
+
+  // Coordenadas de textura de cada vértice das faces do cubo dentro do tile (frente, direita, trás, esquerda, topo, base)
+  inline constexpr std::array<glm::vec2, 36> FACE_TEXTURE_COORDS = {
+      glm::vec2(1, 1), glm::vec2(0, 1), glm::vec2(0, 0), glm::vec2(1, 0), glm::vec2(1, 1), glm::vec2(0, 0), // Front face
+      glm::vec2(1, 1), glm::vec2(0, 1), glm::vec2(0, 0), glm::vec2(1, 0), glm::vec2(1, 1), glm::vec2(0, 0), // Right face
+      glm::vec2(0, 0), glm::vec2(1, 0), glm::vec2(1, 1), glm::vec2(0, 1), glm::vec2(0, 0), glm::vec2(1, 1), // Back face
+      glm::vec2(1, 1), glm::vec2(0, 1), glm::vec2(0, 0), glm::vec2(1, 0), glm::vec2(1, 1), glm::vec2(0, 0), // Left face
+      glm::vec2(1, 1), glm::vec2(0, 1), glm::vec2(0, 0), glm::vec2(1, 0), glm::vec2(1, 1), glm::vec2(0, 0), // Top face
+      glm::vec2(1, 1), glm::vec2(0, 1), glm::vec2(0, 0), glm::vec2(1, 0), glm::vec2(1, 1), glm::vec2(0, 0)  // Bottom face
+  };
+
+  constexpr glm::vec2 TILE_SIZE = glm::vec2(1.0f / HORIZONTAL_TEXTURE_COUNT, 1.0f / VERTICAL_TEXTURE_COUNT);
+
+  constexpr int GetFaceTile(const TextureInfo &texture, int face)
+  {
+    return face == 0 ? texture.face : face == 4 ? texture.top : face == 5 ? texture.bottom : texture.side;
+  }
+
+  constexpr glm::vec2 GetTileOrigin(int tile)
+  {
+    return glm::vec2(TILE_SIZE.x * (tile % HORIZONTAL_TEXTURE_COUNT), TILE_SIZE.y * ((VERTICAL_TEXTURE_COUNT - 1) - tile / HORIZONTAL_TEXTURE_COUNT));
+  }
+
+  constexpr uint64_t ComputeMask(bool BlockBaseInformation::*property)
+  {
+    uint64_t mask = 0;
+
+    for (int i = 0; i < BLOCK_COUNT; i++)
+      if (BLOCK_ATLAS[i].*property)
+        mask |= uint64_t(1) << i;
+
+    return mask;
+  }
+
+  constexpr std::array<std::array<int, 6>, BLOCK_COUNT> ComputeFaceTiles()
+  {
+    std::array<std::array<int, 6>, BLOCK_COUNT> tiles = {};
+
+    for (int i = 0; i < BLOCK_COUNT; i++)
+      for (int face = 0; face < 6; face++)
+        tiles[i][face] = GetFaceTile(BLOCK_ATLAS[i].textureReference, face);
+
+    return tiles;
+  }
+
+  constexpr std::array<BlockInformation, BLOCK_COUNT> ComputeBlockInformation()
+  {
+    std::array<BlockInformation, BLOCK_COUNT> blocks = {};
+
+    for (int i = 0; i < BLOCK_COUNT; i++)
+    {
+      const BlockBaseInformation &base = BLOCK_ATLAS[i];
+
+      blocks[i].blockId = base.blockId;
+      blocks[i].textureReference = base.textureReference;
+      blocks[i].isOpaque = base.isOpaque;
+      blocks[i].isSolid = base.isSolid;
+
+      // Coordenadas no atlas de cada vértice das faces do bloco
+      for (int index = 0; index < 36; index++)
+      {
+        glm::vec2 origin = GetTileOrigin(GetFaceTile(base.textureReference, index / 6));
+
+        blocks[i].textureCoordinates[index] = glm::vec2(
+            FACE_TEXTURE_COORDS[index].x == 0 ? origin.x : origin.x + TILE_SIZE.x,
+            FACE_TEXTURE_COORDS[index].y == 0 ? origin.y : origin.y + TILE_SIZE.y);
+      }
+    }
+
+    return blocks;
+  }
+
+  // Hash FNV-1a do nome do bloco, com uma semente escolhida para não haver colisões na tabela de nomes
+  constexpr uint32_t HashName(const char *name, uint32_t seed)
+  {
+    uint32_t hash = 2166136261u ^ seed;
+
+    for (; *name != 0; name++)
+      hash = (hash ^ static_cast<uint8_t>(*name)) * 16777619u;
+
+    return hash ^ (hash >> 16);
+  }
+
+  const int NAME_TABLE_SIZE = 256;
+  const uint8_t NAME_TABLE_EMPTY = 0xFF;
+
+  constexpr bool IsNameSeedPerfect(uint32_t seed)
+  {
+    bool used[NAME_TABLE_SIZE] = {};
+
+    for (int i = 0; i < BLOCK_COUNT; i++)
+    {
+      uint32_t slot = HashName(BLOCK_ATLAS[i].blockId, seed) % NAME_TABLE_SIZE;
+
+      if (used[slot])
+        return false;
+
+      used[slot] = true;
+    }
+
+    return true;
+  }
+
+  constexpr uint32_t FindNameSeed()
+  {
+    uint32_t seed = 0;
+
+    while (!IsNameSeedPerfect(seed))
+      seed++;
+
+    return seed;
+  }
+
+  constexpr uint32_t NAME_SEED = FindNameSeed();
+
+  constexpr std::array<uint8_t, NAME_TABLE_SIZE> ComputeNameTable()
+  {
+    std::array<uint8_t, NAME_TABLE_SIZE> table = {};
+
+    for (int i = 0; i < NAME_TABLE_SIZE; i++)
+      table[i] = NAME_TABLE_EMPTY;
+
+    for (int i = 0; i < BLOCK_COUNT; i++)
+      table[HashName(BLOCK_ATLAS[i].blockId, NAME_SEED) % NAME_TABLE_SIZE] = static_cast<uint8_t>(i);
+
+    return table;
+  }
+
+  // Bit i indica a propriedade do bloco i
+  constexpr uint64_t OPAQUE_MASK = ComputeMask(&BlockBaseInformation::isOpaque);
+  constexpr uint64_t SOLID_MASK = ComputeMask(&BlockBaseInformation::isSolid);
+
+  inline constexpr std::array<std::array<int, 6>, BLOCK_COUNT> FACE_TILES = ComputeFaceTiles();
+  inline constexpr std::array<BlockInformation, BLOCK_COUNT> BLOCK_INFORMATION = ComputeBlockInformation();
+
+  // Índice do bloco a partir do hash do nome; a semente garante um bloco por posição
+  inline constexpr std::array<uint8_t, NAME_TABLE_SIZE> NAME_TABLE = ComputeNameTable();
+}
+
 class BlockDatabase
 {
 private:
   BlockDatabase() {}
 
-  static const int HORIZONTAL_TEXTURE_COUNT = 32;
-  static const int VERTICAL_TEXTURE_COUNT = 11;
+public:
+  // A tabela de blocos é gerada em tempo de compilação, então não há nada para calcular
+  static void Initialize() {}
 
-  static BlockInformation blockInformation[BLOCK_COUNT];
+  static const BlockInformation &GetBlockInformation(const std::string &blockId)
+  {
+    int index = BlockTable::NAME_TABLE[BlockTable::HashName(blockId.c_str(), BlockTable::NAME_SEED) % BlockTable::NAME_TABLE_SIZE];
 
-public:
-  static void Initialize();
+    // Nomes desconhecidos caem em uma posição vazia ou de outro bloco
+    if (index == BlockTable::NAME_TABLE_EMPTY || strcmp(BLOCK_ATLAS[index].blockId, blockId.c_str()) != 0)
+      return BlockTable::BLOCK_INFORMATION[0];
+
+    return BlockTable::BLOCK_INFORMATION[index];
+  }
+
+  static const BlockInformation &GetBlockInformationIndex(int index) { return BlockTable::BLOCK_INFORMATION[index]; }
+
+  // Propriedades consultadas nos laços internos, lidas das máscaras sem desvios
+  static bool IsOpaque(int index) { return (BlockTable::OPAQUE_MASK >> index) & 1; }
+  static bool IsSolid(int index) { return (BlockTable::SOLID_MASK >> index) & 1; }
+
+  // Índice no atlas da textura de uma face do bloco (frente, direita, trás, esquerda, topo, base)
+  static int GetFaceTile(int index, int face) { return BlockTable::FACE_TILES[index][face]; }
 
-  static BlockInformation GetBlockInformation(std::string blockId);
-  static BlockInformation GetBlockInformationIndex(int index);
+  // Canto inferior esquerdo e tamanho de um tile nas coordenadas do atlas
+  static glm::vec2 GetTileOrigin(int tile) { return BlockTable::GetTileOrigin(tile); }
+  static glm::vec2 GetTileSize() { return BlockTable::TILE_SIZE; }
 };
 
 #endif
\ No newline at end of file
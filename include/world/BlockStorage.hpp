@@ -0,0 +1,98 @@
+#ifndef _BLOCKSTORAGE_H
+#define _BLOCKSTORAGE_H
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "world/BlockDatabase.hpp"
+
+// Armazenamento compacto de blocos baseado em paleta
+// Cada voxel guarda apenas o índice do seu bloco na paleta, empacotado com 0, 1, 2, 4 ou 8 bits
+// dependendo da quantidade de blocos distintos presentes no volume
+class BlockStorage
+{
+private:
+  static const int MAX_BITS_PER_BLOCK = 8;
+  static const uint8_t NOT_IN_PALETTE = 0xFF;
+
+  int m_Size;
+
+  int m_BitsPerBlock;
+  int m_BlocksPerWordShift;
+  uint64_t m_IndexMask;
+
+  std::vector<int> m_Palette;
+  std::vector<int> m_PaletteCounts;
+  std::array<uint8_t, BLOCK_COUNT> m_PaletteLookup;
+
+  std::vector<uint64_t> m_Data;
+
+  // Retorna o índice na paleta do voxel
+  int GetPaletteIndex(int index) const
+  {
+    if (m_BitsPerBlock == 0)
+      return 0;
+
+    uint64_t word = m_Data[index >> m_BlocksPerWordShift];
+    int shift = (index & ((1 << m_BlocksPerWordShift) - 1)) * m_BitsPerBlock;
+
+    return static_cast<int>((word >> shift) & m_IndexMask);
+  }
+
+  void SetPaletteIndex(int index, int paletteIndex);
+
+  int AddToPalette(int block);
+  void Resize(int bitsPerBlock);
+  void SetLayout(int bitsPerBlock);
+
+public:
+  BlockStorage(int size, int initialBlock = AIR);
+
+  int Get(int index) const { return m_Palette[GetPaletteIndex(index)]; }
+  void Set(int index, int block);
+
+  // Preenche todo o volume com um único bloco
+  void Fill(int block);
+
+  // Carrega m_Size blocos de uma vez, montando a paleta e empacotando os índices em uma única passada
+  void Load(const uint8_t *blocks);
+
+  // Remove da paleta os blocos que não estão mais presentes e reduz os bits por voxel
+  void Compact();
+
+  int GetSize() const { return m_Size; }
+  int GetBitsPerBlock() const { return m_BitsPerBlock; }
+  int GetPaletteSize() const { return static_cast<int>(m_Palette.size()); }
+
+  // Bloco e quantidade de voxels de uma entrada da paleta
+  int GetPaletteBlock(int paletteIndex) const { return m_Palette[paletteIndex]; }
+  int GetPaletteCount(int paletteIndex) const { return m_PaletteCounts[paletteIndex]; }
+
+  // Quantidade de voxels com o bloco
+  int GetBlockCount(int block) const
+  {
+    int paletteIndex = m_PaletteLookup[block];
+
+    return paletteIndex == NOT_IN_PALETTE ? 0 : m_PaletteCounts[paletteIndex];
+  }
+
+  // Retorna o bloco que ocupa todo o volume, ou -1 se há mais de um bloco
+  int GetUniformBlock() const
+  {
+    for (size_t i = 0; i < m_Palette.size(); i++)
+      if (m_PaletteCounts[i] == m_Size)
+        return m_Palette[i];
+
+    return -1;
+  }
+
+  void Serialize(std::vector<uint8_t> &out) const;
+  size_t Deserialize(const uint8_t *data);
+
+  // Memória ocupada pelo armazenamento, em bytes
+  size_t GetMemoryUsage() const;
+};
+
+#endif
@@ -1,49 +1,193 @@
 #ifndef _CHUNK_H
 #define _CHUNK_H
 
+#include <cstdint>
 #include <vector>
 
-#include "engine/VertexArray.hpp"
-#include "engine/VertexBuffer.hpp"
-#include "engine/VertexBufferLayout.hpp"
-#include "engine/Shader.hpp"
-#include "engine/Texture.hpp"
+#include "engine/VertexArena.hpp"
 
 #include "world/Cube.hpp"
+#include "world/ChunkSection.hpp"
+#include "world/SectionVisibility.hpp"
 #include "world/WorldConstants.hpp"
 
 // Classe para representação de um chunk
 class Chunk
 {
+public:
+  // Lado, em colunas, de cada célula do casco de oclusão do terreno
+  static const int HULL_CELL_SIZE = 4;
+  static const int HULL_CELLS = WorldConstants::CHUNK_SIZE / HULL_CELL_SIZE;
+
 private:
   int m_ChunkX;
   int m_ChunkZ;
 
-  VertexArray *m_VAO;
-  VertexBuffer *m_VBO;
+  // Geometria de uma seção na arena de vértices do World, alocada só quando a seção tem vértices
+  struct SectionMesh
+  {
+    int allocation = BufferAllocator::INVALID;
+    int vertexCount = 0;
+  };
+
+  // Arena onde as meshes foram enviadas, definida no primeiro envio
+  VertexArena *m_VertexArena = nullptr;
+
+  // Meshes opacas e transparentes de cada seção em alocações separadas, para uma edição reenviar só as seções afetadas
+  std::array<SectionMesh, WorldConstants::SECTIONS_PER_CHUNK> m_SectionMeshes;
+  std::array<SectionMesh, WorldConstants::SECTIONS_PER_CHUNK> m_TransparentSectionMeshes;
+
+  // Menor e maior altura dos vértices de cada seção e do chunk inteiro, registradas ao gerar a mesh
+  // Sem vértices, o mínimo fica maior que o máximo
+  std::array<glm::ivec2, WorldConstants::SECTIONS_PER_CHUNK> m_SectionBounds;
+  glm::ivec2 m_Bounds;
+
+  // Pares de faces de cada seção ligados por blocos não opacos, calculados junto com a mesh
+  // Antes da primeira mesh todas as faces são consideradas ligadas
+  std::array<uint16_t, WorldConstants::SECTIONS_PER_CHUNK> m_SectionConnectivity;
+
+  bool m_HasMesh = false;
+
+  bool m_IsModified = false;
+
+  // Seções com a mesh desatualizada, um bit por seção, e se alguma delas foi editada pelo jogador
+  uint16_t m_DirtySections = 0;
+  bool m_IsDirtyByPlayer = false;
+
+  // Seções alcançadas pelo último percurso do grafo de visibilidade do World
+  uint16_t m_ReachableSections = 0;
 
-  int m_MeshVertexCount;
+  // Versão da última mesh pedida ao World para cada seção
+  std::array<uint32_t, WorldConstants::SECTIONS_PER_CHUNK> m_SectionMeshVersions = {};
 
-  VertexArray *m_TransparentVAO;
-  VertexBuffer *m_TransparentVBO;
+  std::array<ChunkSection, WorldConstants::SECTIONS_PER_CHUNK> m_Sections;
 
-  int m_TransparentMeshVertexCount;
+  // Altura até onde todas as colunas de cada célula do casco são opacas desde a base, usada como oclusor
+  // Edições só podem baixar essa altura, então o casco continua dentro do terreno
+  std::array<int, HULL_CELLS * HULL_CELLS> m_HullHeights;
 
-  std::array<std::array<std::array<int, WorldConstants::CHUNK_SIZE>, WorldConstants::CHUNK_HEIGHT>, WorldConstants::CHUNK_SIZE> m_Cubes;
+  // Recalcula o casco lendo os blocos de todas as colunas
+  void UpdateHullHeights();
+
+  bool GetBox(glm::ivec2 bounds, glm::vec3 *min, glm::vec3 *max) const
+  {
+    glm::vec3 origin = glm::vec3(m_ChunkX * WorldConstants::CHUNK_SIZE, 0.0f, m_ChunkZ * WorldConstants::CHUNK_SIZE);
+
+    *min = origin + glm::vec3(0.0f, bounds.x, 0.0f);
+    *max = origin + glm::vec3(WorldConstants::CHUNK_SIZE, bounds.y, WorldConstants::CHUNK_SIZE);
+
+    return bounds.x <= bounds.y;
+  }
+
+  void UploadSectionMesh(SectionMesh &mesh, const std::vector<CubeVertex> &vertices);
+  void DeleteSectionMesh(SectionMesh &mesh);
 
 public:
+  static_assert(WorldConstants::SECTIONS_PER_CHUNK <= 16, "As máscaras de seções usam 16 bits");
+
+  static const uint16_t ALL_SECTIONS = (1 << WorldConstants::SECTIONS_PER_CHUNK) - 1;
+
+  // Índices das seções, da mais próxima da câmera para a mais distante
+  typedef std::array<int, WorldConstants::SECTIONS_PER_CHUNK> SectionOrder;
+
   Chunk(int chunkX, int chunkZ);
   ~Chunk();
 
   int GetChunkX() const { return m_ChunkX; }
   int GetChunkZ() const { return m_ChunkZ; }
 
-  int GetCube(glm::vec3 position) const { return m_Cubes[position.x][position.y][position.z]; }
-  void SetCube(glm::vec3 position, int block) { m_Cubes[position.x][position.y][position.z] = block; }
+  int GetCube(int x, int y, int z) const
+  {
+    if (y < 0 || y >= WorldConstants::CHUNK_HEIGHT)
+      return AIR;
+
+    const ChunkSection &section = m_Sections[y / WorldConstants::SECTION_HEIGHT];
+
+    // Seções vazias não precisam consultar o armazenamento
+    if (section.IsEmpty())
+      return AIR;
+
+    return section.GetCube(x, y % WorldConstants::SECTION_HEIGHT, z);
+  }
+
+  void SetCube(int x, int y, int z, int block)
+  {
+    m_Sections[y / WorldConstants::SECTION_HEIGHT].SetCube(x, y % WorldConstants::SECTION_HEIGHT, z, block);
+
+    // Um bloco transparente abaixo do casco abre um buraco na célula
+    int &hullHeight = m_HullHeights[(z / HULL_CELL_SIZE) * HULL_CELLS + x / HULL_CELL_SIZE];
+
+    if (!BlockDatabase::IsOpaque(block) && y < hullHeight)
+      hullHeight = y;
+  }
+
+  int GetCube(glm::vec3 position) const { return GetCube(position.x, position.y, position.z); }
+  void SetCube(glm::vec3 position, int block) { SetCube(position.x, position.y, position.z, block); }
+
+  const ChunkSection &GetSection(int section) const { return m_Sections[section]; }
+
+  int GetHullHeight(int cellX, int cellZ) const { return m_HullHeights[cellZ * HULL_CELLS + cellX]; }
+
+  // Serializa os blocos do chunk, ignorando as seções vazias
+  void Serialize(std::vector<uint8_t> &out) const;
+  void Deserialize(const std::vector<uint8_t> &data);
+
+  // Memória ocupada pelos blocos do chunk, em bytes
+  size_t GetMemoryUsage() const;
+
+  // Chunks modificados pelo jogador precisam ser salvos antes de serem descarregados
+  bool IsModified() const { return m_IsModified; }
+  void MarkModified() { m_IsModified = true; }
+
+  bool HasMesh() const { return m_HasMesh; }
+
+  // Marca seções para terem a mesh reconstruída; marcas repetidas antes da reconstrução se acumulam na mesma máscara
+  void MarkSectionsDirty(uint16_t sections, bool isPlayerEdit)
+  {
+    m_DirtySections |= sections;
+    m_IsDirtyByPlayer = m_IsDirtyByPlayer || isPlayerEdit;
+  }
+
+  uint16_t GetDirtySections() const { return m_DirtySections; }
+  bool IsDirtyByPlayer() const { return m_IsDirtyByPlayer; }
+
+  void ClearDirtySections()
+  {
+    m_DirtySections = 0;
+    m_IsDirtyByPlayer = false;
+  }
+
+  // Versão da última mesh pedida para as seções; meshes geradas para versões anteriores são descartadas
+  uint32_t GetSectionMeshVersion(int section) const { return m_SectionMeshVersions[section]; }
+
+  void SetSectionMeshVersion(uint16_t sections, uint32_t version)
+  {
+    for (int section = 0; section < WorldConstants::SECTIONS_PER_CHUNK; section++)
+      if (sections & (1 << section))
+        m_SectionMeshVersions[section] = version;
+  }
+
+  // Substitui a mesh e a conectividade de uma seção, reenviando apenas os vértices dela para a arena
+  void UploadMesh(VertexArena *arena, int section, const std::vector<CubeVertex> &vertices, const std::vector<CubeVertex> &transparentVertices, glm::ivec2 verticalBounds, uint16_t connectivity);
+
+  uint16_t GetSectionConnectivity(int section) const { return m_SectionConnectivity[section]; }
+
+  uint16_t GetReachableSections() const { return m_ReachableSections; }
+  void ClearReachableSections() { m_ReachableSections = 0; }
+  void AddReachableSection(int section) { m_ReachableSections |= 1 << section; }
+
+  // Caixa em coordenadas do mundo com os limites verticais da mesh do chunk ou de uma seção
+  // Retorna false se a mesh não tem vértices
+  bool GetBox(glm::vec3 *min, glm::vec3 *max) const { return GetBox(m_Bounds, min, max); }
+  bool GetSectionBox(int section, glm::vec3 *min, glm::vec3 *max) const { return GetBox(m_SectionBounds[section], min, max); }
 
-  void BuildMesh(std::array<Chunk *, 4> neighbors);
+  // Quantidade de vértices da mesh atual (opaca e transparente)
+  int GetVertexCount() const;
 
-  void Draw(Shader *shader);
+  // Adiciona à lista de desenho os intervalos da arena das seções marcadas em sections (um bit por seção)
+  // As opacas vão da seção mais próxima da câmera para a mais distante, e as transparentes no sentido contrário
+  void AddOpaqueDraws(uint16_t sections, const SectionOrder &order, DrawList &draws) const;
+  void AddTransparentDraws(uint16_t sections, const SectionOrder &order, DrawList &draws) const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,103 @@
+#ifndef _CHUNKMESHER_H
+#define _CHUNKMESHER_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "world/Chunk.hpp"
+#include "world/ChunkSection.hpp"
+#include "world/Cube.hpp"
+#include "world/WorldConstants.hpp"
+
+// Algoritmo usado para gerar a mesh dos chunks
+enum MeshingMode
+{
+  MM_NAIVE,  // Dois triângulos por face visível
+  MM_GREEDY, // Faces coplanares do mesmo bloco unidas em retângulos máximos
+};
+
+// Cópia imutável dos blocos de um chunk e da borda dos quatro vizinhos
+// Criada na thread principal, permite gerar a mesh em outra thread enquanto o mundo continua sendo editado
+// Só as seções pedidas, as seções logo acima e abaixo delas e a borda dos vizinhos na mesma altura são copiadas
+class ChunkSnapshot
+{
+private:
+  static const int BORDER_SIZE = WorldConstants::CHUNK_SIZE * WorldConstants::CHUNK_HEIGHT;
+
+  std::array<ChunkSection, WorldConstants::SECTIONS_PER_CHUNK> m_Sections;
+
+  // Blocos dos vizinhos encostados em cada lado do chunk (na ordem de World::GetNeighbors),
+  // indexados por y * CHUNK_SIZE + posição ao longo do lado
+  std::array<std::array<uint8_t, BORDER_SIZE>, 4> m_Borders;
+
+  // Seções dos vizinhos ocupadas por um único bloco opaco
+  std::array<std::array<bool, WorldConstants::SECTIONS_PER_CHUNK>, 4> m_IsNeighborSectionOpaque;
+
+public:
+  ChunkSnapshot(const Chunk &chunk, const std::array<Chunk *, 4> &neighbors, uint16_t sections = Chunk::ALL_SECTIONS);
+
+  // Bloco na posição local, consultando a borda dos vizinhos fora dos limites horizontais do chunk
+  int GetCube(int x, int y, int z) const
+  {
+    if (y < 0 || y >= WorldConstants::CHUNK_HEIGHT)
+      return AIR;
+
+    bool isOutsideX = x < 0 || x >= WorldConstants::CHUNK_SIZE;
+    bool isOutsideZ = z < 0 || z >= WorldConstants::CHUNK_SIZE;
+
+    if (!isOutsideX && !isOutsideZ)
+    {
+      const ChunkSection &section = m_Sections[y / WorldConstants::SECTION_HEIGHT];
+
+      if (section.IsEmpty())
+        return AIR;
+
+      return section.GetCube(x, y % WorldConstants::SECTION_HEIGHT, z);
+    }
+
+    // Os vizinhos nas diagonais não são necessários para a oclusão das faces
+    if (isOutsideX && isOutsideZ)
+      return AIR;
+
+    if (x < 0)
+      return m_Borders[0][y * WorldConstants::CHUNK_SIZE + z];
+
+    if (x >= WorldConstants::CHUNK_SIZE)
+      return m_Borders[2][y * WorldConstants::CHUNK_SIZE + z];
+
+    if (z < 0)
+      return m_Borders[3][y * WorldConstants::CHUNK_SIZE + x];
+
+    return m_Borders[1][y * WorldConstants::CHUNK_SIZE + x];
+  }
+
+  // Testa se a seção não gera nenhuma face: vazia, ou opaca e cercada por seções opacas
+  bool CanSkipSection(int section) const;
+
+  const ChunkSection &GetSection(int section) const { return m_Sections[section]; }
+};
+
+// Geração da mesh de um chunk a partir de uma cópia dos seus blocos
+// Não acessa o mundo nem a GPU, então pode ser executada em qualquer thread
+class ChunkMesher
+{
+private:
+  ChunkMesher() {}
+  ~ChunkMesher() {}
+
+  static void BuildNaiveMesh(const ChunkSnapshot &snapshot, int section, std::vector<CubeVertex> &vertices, std::vector<CubeVertex> &transparentVertices);
+  static void BuildGreedyMesh(const ChunkSnapshot &snapshot, int section, std::vector<CubeVertex> &vertices, std::vector<CubeVertex> &transparentVertices);
+
+public:
+  // Substitui o conteúdo de vertices e transparentVertices pela mesh opaca e transparente de uma seção
+  // Retorna zero se a seção foi pulada por CanSkipSection e o volume inteiro da seção caso contrário,
+  // então a contagem de voxels visitados soma seções inteiras, gerem elas faces ou não
+  static int BuildMesh(const ChunkSnapshot &snapshot, int section, MeshingMode mode, std::vector<CubeVertex> &vertices, std::vector<CubeVertex> &transparentVertices);
+
+  // Menor e maior altura dos vértices da mesh, usadas como limites verticais da caixa de culling
+  // Sem vértices, o mínimo fica maior que o máximo
+  static glm::ivec2 GetVerticalBounds(const std::vector<CubeVertex> &vertices, const std::vector<CubeVertex> &transparentVertices);
+};
+
+#endif
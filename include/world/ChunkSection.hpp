@@ -0,0 +1,68 @@
+#ifndef _CHUNKSECTION_H
+#define _CHUNKSECTION_H
+
+#include "world/BlockDatabase.hpp"
+#include "world/BlockStorage.hpp"
+#include "world/WorldConstants.hpp"
+
+// Seção vertical de 16x16x16 blocos de um chunk
+// A ocupação da paleta indica se a seção é toda de ar ou toda de um único bloco opaco
+class ChunkSection
+{
+private:
+  BlockStorage m_Blocks;
+
+public:
+  static const int VOLUME = WorldConstants::CHUNK_SIZE * WorldConstants::SECTION_HEIGHT * WorldConstants::CHUNK_SIZE;
+
+  ChunkSection() : m_Blocks(VOLUME) {}
+
+  // Índice do bloco na seção (camadas horizontais contíguas)
+  static int GetBlockIndex(int x, int y, int z)
+  {
+    return (y * WorldConstants::CHUNK_SIZE + z) * WorldConstants::CHUNK_SIZE + x;
+  }
+
+  int GetCube(int x, int y, int z) const { return m_Blocks.Get(GetBlockIndex(x, y, z)); }
+  void SetCube(int x, int y, int z, int block) { m_Blocks.Set(GetBlockIndex(x, y, z), block); }
+
+  void Fill(int block) { m_Blocks.Fill(block); }
+  void Compact() { m_Blocks.Compact(); }
+
+  // Carrega os VOLUME blocos da seção, indexados como GetBlockIndex
+  void Load(const uint8_t *blocks) { m_Blocks.Load(blocks); }
+
+  // Quantidade de blocos diferentes de ar na seção
+  int GetBlockCount() const { return VOLUME - m_Blocks.GetBlockCount(AIR); }
+
+  bool IsEmpty() const { return m_Blocks.GetBlockCount(AIR) == VOLUME; }
+
+  // Retorna o bloco que ocupa toda a seção, ou -1 se há mais de um bloco
+  int GetUniformBlock() const { return m_Blocks.GetUniformBlock(); }
+
+  bool IsUniformOpaque() const
+  {
+    int block = GetUniformBlock();
+
+    return block >= 0 && BlockDatabase::IsOpaque(block);
+  }
+
+  // Seção sem nenhum voxel transparente, mesmo que tenha blocos diferentes
+  bool IsFullyOpaque() const
+  {
+    int opaqueCount = 0;
+
+    for (int i = 0; i < m_Blocks.GetPaletteSize(); i++)
+      if (BlockDatabase::IsOpaque(m_Blocks.GetPaletteBlock(i)))
+        opaqueCount += m_Blocks.GetPaletteCount(i);
+
+    return opaqueCount == VOLUME;
+  }
+
+  const BlockStorage &GetStorage() const { return m_Blocks; }
+  BlockStorage &GetStorage() { return m_Blocks; }
+
+  size_t GetMemoryUsage() const { return m_Blocks.GetMemoryUsage(); }
+};
+
+#endif
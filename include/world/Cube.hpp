@@ -1,16 +1,32 @@
 #ifndef _CUBE_H
 #define _CUBE_H
 
+#include <cstdint>
 #include <vector>
 
 #include "world/BlockDatabase.hpp"
 
-// Classe para cálculo de vértices de um cubo
+// Vértice empacotado em 8 bytes, decodificado em World.shader
+// position: x (5 bits), y (9 bits), z (5 bits) locais ao chunk e a face da normal (3 bits)
+// texture: tile do atlas (8 bits) e coordenadas u e v locais ao tile (5 bits cada), que repetem a cada bloco
 struct CubeVertex
 {
-  glm::vec4 position;
-  glm::vec2 textureCoords;
-  glm::vec4 normal;
+  uint32_t position;
+  uint32_t texture;
+};
+
+// Tamanho do vértice sem empacotamento (posição vec4, textura vec2, normal vec4 e origem do tile vec2), para comparação
+const size_t UNPACKED_VERTEX_SIZE = 48;
+
+// Faces do cubo, na mesma ordem da oclusão
+enum CubeFace
+{
+  CF_FRONT,
+  CF_RIGHT,
+  CF_BACK,
+  CF_LEFT,
+  CF_TOP,
+  CF_BOTTOM
 };
 
 class Cube
@@ -20,7 +36,42 @@ private:
   ~Cube() {}
 
 public:
-  static std::vector<CubeVertex> GetVisibleVertices(int blockIndex, glm::vec3 position, std::array<glm::vec2, 36> vertices, std::array<bool, 6> occludedFaces);
+  static CubeVertex PackVertex(glm::ivec3 position, int face, int tile, glm::ivec2 textureCoords)
+  {
+    CubeVertex vertex;
+
+    vertex.position = position.x | (position.y << 5) | (position.z << 14) | (face << 19);
+    vertex.texture = tile | (textureCoords.x << 8) | (textureCoords.y << 13);
+
+    return vertex;
+  }
+
+  // Altura do vértice empacotado, em blocos locais ao chunk
+  static int GetVertexY(CubeVertex vertex) { return (vertex.position >> 5) & 0x1FF; }
+
+  // Adiciona no final de vertices as faces do bloco que não estão oclusas
+  static void AddVisibleFaces(std::vector<CubeVertex> &vertices, int blockIndex, glm::vec3 position, const std::array<bool, 6> &occludedFaces);
+
+  // Adiciona uma face que cobre size blocos a partir de position (size vale 1 no eixo da normal)
+  // A textura se repete uma vez por bloco coberto
+  static void AddFace(std::vector<CubeVertex> &vertices, int blockIndex, int face, glm::vec3 position, glm::vec3 size);
+
+  // Eixos (0 = x, 1 = y, 2 = z) da normal e das coordenadas u e v da textura de cada face
+  static int GetNormalAxis(int face);
+  static int GetTextureAxisU(int face);
+  static int GetTextureAxisV(int face);
+
+  // Testa se a face do bloco é escondida pelo bloco vizinho
+  static bool IsFaceOccluded(int blockIndex, int neighborIndex)
+  {
+    bool isNeighborOpaque = BlockDatabase::IsOpaque(neighborIndex);
+
+    // Blocos transparentes também escondem as faces entre dois blocos iguais
+    return isNeighborOpaque | (!BlockDatabase::IsOpaque(blockIndex) & (neighborIndex == blockIndex));
+  }
+
+  // A água não tem a face de baixo
+  static bool HasFace(int blockIndex, int face) { return blockIndex != WATER || face != CF_BOTTOM; }
 };
 
-#endif
\ No newline at end of file
+#endif
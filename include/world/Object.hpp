@@ -3,6 +3,8 @@
 
 #include "core.h"
 
+#include "engine/GLState.hpp"
+#include "engine/RenderQueue.hpp"
 #include "engine/VertexArray.hpp"
 #include "engine/VertexBuffer.hpp"
 #include "engine/VertexBufferLayout.hpp"
@@ -20,6 +22,7 @@ private:
 
   GLuint m_VertexArrayObjectId;
   GLuint m_VertexBufferObjectId;
+  GLuint m_IndexBufferId;
   int m_IndexCount;
   int m_FirstIndex;
 
@@ -27,6 +30,11 @@ private:
   std::vector<tinyobj::shape_t> m_Shapes;
   std::vector<tinyobj::material_t> m_Materials;
 
+  // Uniforms resolvidos para o último shader usado no desenho
+  Shader *m_UniformShader = nullptr;
+  Uniform<glm::mat4> m_ModelUniform;
+  Uniform<int> m_IsGouraudUniform;
+
 public:
   Object(std::string filename, float objectX, float objectZ);
   ~Object();
@@ -37,7 +45,7 @@ public:
   void ComputeNormals();
   void BuildVertices();
 
-  void Draw(Shader *shader, glm::mat4 view, glm::mat4 projection, bool isGouraud);
+  void Draw(RenderQueue &queue, Shader *shader, glm::vec4 cameraPosition, bool isGouraud);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef _SECTIONVISIBILITY_H
+#define _SECTIONVISIBILITY_H
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+#include "world/ChunkSection.hpp"
+#include "world/WorldConstants.hpp"
+
+// Faces de uma seção; a face oposta de cada uma é face ^ 1
+enum SectionFace
+{
+  SF_WEST,  // -x
+  SF_EAST,  // +x
+  SF_DOWN,  // -y
+  SF_UP,    // +y
+  SF_NORTH, // -z
+  SF_SOUTH, // +z
+};
+
+// Grafo de visibilidade entre seções (cave culling)
+// Cada seção guarda quais pares das suas seis faces estão ligados por blocos não opacos, um bit por par (15 bits),
+// e o percurso em largura a partir da seção da câmera só atravessa uma seção entre faces ligadas
+class SectionVisibility
+{
+private:
+  SectionVisibility() {}
+  ~SectionVisibility() {}
+
+  // Bit do par de faces (a, b) na máscara de conectividade, com a != b
+  static int GetPairBit(int a, int b)
+  {
+    if (a > b)
+      std::swap(a, b);
+
+    return a * 5 - a * (a - 1) / 2 + b - a - 1;
+  }
+
+public:
+  static const uint16_t ALL_CONNECTED = 0x7FFF;
+  static const uint16_t NONE_CONNECTED = 0;
+
+  // Conectividade pelo flood fill dos blocos não opacos da seção
+  static uint16_t ComputeConnectivity(const ChunkSection &section);
+
+  // Une todas as faces tocadas por uma mesma região de blocos não opacos
+  static uint16_t ConnectFaces(int faces);
+
+  static bool AreFacesConnected(uint16_t connectivity, int a, int b) { return a != b && (connectivity & (1 << GetPairBit(a, b))) != 0; }
+
+  // Retorna a conectividade da seção em (chunkX, seção, chunkZ), ou -1 se o chunk não está carregado
+  typedef std::function<int(glm::ivec3)> ConnectivityCallback;
+
+  // Chamada na primeira vez que o percurso chega a uma seção; retorna false para não continuar a partir dela
+  typedef std::function<bool(glm::ivec3)> VisitCallback;
+
+  // Percurso em largura a partir da seção start, limitado a radius chunks de distância em x e z
+  // Uma seção só é atravessada da face de entrada para faces ligadas a ela, e o caminho nunca volta na direção
+  // oposta a uma já percorrida, como uma linha de visão; a ordem de visita é determinística
+  static void Traverse(glm::ivec3 start, int radius, const ConnectivityCallback &getConnectivity, const VisitCallback &visit);
+};
+
+#endif
@@ -1,9 +1,21 @@
 #ifndef _TERRAINGENERATION_H
 #define _TERRAINGENERATION_H
 
+#include <cstdint>
+
 #include "world/Noise.hpp"
 #include "world/WorldConstants.hpp"
 
+// Faixas de blocos de uma coluna do terreno, da base ao topo (intervalos fechados, vazios se fim < início)
+struct ColumnSpans
+{
+  int stoneTop;     // bedrock em y = 0 e pedra em [1, stoneTop]
+  int dirtTop;      // terra em [stoneTop + 1, dirtTop]
+  int surface;      // bloco da superfície em y = surface
+  int surfaceBlock;
+  int waterTop;     // água em [surface + 1, waterTop] e ar acima
+};
+
 // Classe para geração de terreno
 class TerrainGeneration
 {
@@ -33,9 +45,27 @@ private:
     return bumpedValue * 0.9f;
   }
 
+  static int CombineHeight(float noise, float noise2, double island);
+
 public:
   static int GetHeight(glm::vec2 blockPosition, glm::vec2 chunkPosition);
-  static int GetBlockAtHeight(int y, int height);
+
+  // Calcula as CHUNK_SIZE x CHUNK_SIZE alturas do chunk de uma vez, em heights[x + z * CHUNK_SIZE]
+  static void GetHeightMap(int chunkX, int chunkZ, int *heights);
+
+  // Bloco na posição do mundo, dada a altura do terreno na coluna
+  // É uma função pura da posição: a mesma posição sempre gera o mesmo bloco
+  static int GetBlockAtHeight(int x, int y, int z, int height);
+
+  // Calcula as faixas de blocos da coluna na posição do mundo
+  static ColumnSpans GetColumnSpans(int x, int z, int height);
+
+  // Minério na posição de pedra, ou pedra se não houver minério
+  static int GetOreAt(int x, int y, int z);
+
+  // Preenche os CHUNK_HEIGHT blocos de uma coluna com escritas em faixas, seguidas de uma passada esparsa de minérios
+  // Gera exatamente os mesmos blocos que GetBlockAtHeight
+  static void FillColumn(int x, int z, int height, uint8_t *column);
 };
 
 #endif
\ No newline at end of file
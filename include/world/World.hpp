@@ -1,58 +1,313 @@
 #ifndef _WORLD_H
 #define _WORLD_H
 
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "core/Frustum.hpp"
+#include "core/OcclusionBuffer.hpp"
+#include "core/ThreadPool.hpp"
+
+#include "engine/RenderQueue.hpp"
 #include "engine/Shader.hpp"
 #include "engine/Texture.hpp"
+#include "engine/VertexArena.hpp"
 
 #include "entity/Camera.hpp"
 
 #include "world/Chunk.hpp"
+#include "world/ChunkMesher.hpp"
+#include "world/SectionVisibility.hpp"
 #include "world/WorldConstants.hpp"
 
+// Contadores do frustum culling, do cave culling e do occlusion culling do último frame desenhado
+struct CullingStats
+{
+  int visibleChunks;
+  int culledChunks;
+  int unreachableChunks;
+  int occludedChunks;
+
+  // Seções com faces dos chunks visíveis
+  int visibleSections;
+  int culledSections;
+  int unreachableSections;
+  int occludedSections;
+
+  // Seções alcançadas pelo percurso do grafo de visibilidade, com ou sem faces
+  int traversedSections;
+
+  // Triângulos dos oclusores rasterizados no buffer de oclusão
+  int occluderTriangles;
+
+  // Porcentagem das seções dentro do frustum que foram descartadas por oclusão, contando as dos chunks oclusos
+  float GetOccludedPercentage() const
+  {
+    int total = visibleSections + occludedSections;
+
+    return total > 0 ? 100.0f * occludedSections / total : 0.0f;
+  }
+};
+
+// Geometria do mundo enviada a um pass no último frame
+struct RenderPassStats
+{
+  int drawCalls;
+  int ranges;   // Intervalos de vértices da arena desenhados, um por seção
+  int vertices;
+};
+
 // Classe para representar o mundo
+// Os chunks são carregados e descarregados conforme a câmera se move
 class World
 {
 private:
   Shader *m_Shader;
+  Uniform<int> m_IsOpaqueUniform;
   Texture *m_TextureAtlas;
 
-  std::array<std::array<Chunk *, WorldConstants::CHUNKS_PER_AXIS>, WorldConstants::CHUNKS_PER_AXIS> m_Chunks;
+  std::unordered_map<int64_t, Chunk *> m_Chunks;
+
+  // Meshes de todos os chunks, desenhadas com uma chamada para as seções opacas e outra para as transparentes
+  VertexArena *m_VertexArena;
+
+  DrawList m_OpaqueDraws;
+  DrawList m_TransparentDraws;
+
+  // Chunks carregados do mais próximo ao mais distante do chunk da câmera no momento da ordenação
+  // Chunks novos entram na posição certa e a lista só é reordenada quando a câmera muda de chunk
+  std::vector<Chunk *> m_DrawOrder;
+  glm::ivec2 m_DrawOrderChunk;
+
+  // Ordem das seções dentro de cada chunk, recalculada quando a câmera muda de seção
+  Chunk::SectionOrder m_SectionOrder;
+  int m_DrawOrderSection;
+
+  // Chunks dentro do frustum no frame atual, na ordem de m_DrawOrder, e as seções de cada um que serão desenhadas
+  struct VisibleChunk
+  {
+    Chunk *chunk;
+    uint16_t sections;
+  };
+
+  std::vector<VisibleChunk> m_VisibleChunks;
+
+  // Blocos dos chunks modificados pelo jogador que já foram descarregados
+  std::unordered_map<int64_t, std::vector<uint8_t>> m_SavedChunks;
+
+  std::vector<glm::ivec2> m_ChunksToLoad;
+
+  // Geração dos chunks e das meshes em paralelo; a mesh continua sendo enviada à GPU na thread principal
+  ThreadPool *m_ThreadPool;
+
+  std::unordered_set<int64_t> m_PendingChunks;
+
+  std::mutex m_GeneratedChunksMutex;
+  std::vector<Chunk *> m_GeneratedChunks;
+
+  // Chunks com seções marcadas para atualização, cada um no máximo uma vez
+  std::vector<glm::ivec2> m_ChunksToUpdate;
+
+  // Mesh das seções de um chunk gerada por uma thread de trabalho, esperando para ser enviada à GPU
+  struct MeshedChunk
+  {
+    glm::ivec2 position;
+    uint16_t sections;
+    uint32_t version;
+    bool isPriority;
+
+    int voxelsVisited;
+
+    std::array<glm::ivec2, WorldConstants::SECTIONS_PER_CHUNK> verticalBounds;
+    std::array<uint16_t, WorldConstants::SECTIONS_PER_CHUNK> connectivity;
+
+    std::array<std::vector<CubeVertex>, WorldConstants::SECTIONS_PER_CHUNK> vertices;
+    std::array<std::vector<CubeVertex>, WorldConstants::SECTIONS_PER_CHUNK> transparentVertices;
+  };
+
+  // Todas as meshes alocadas; as livres são reaproveitadas para não alocar os buffers de vértices a cada geração
+  std::vector<std::unique_ptr<MeshedChunk>> m_MeshBuffers;
+  std::vector<MeshedChunk *> m_FreeMeshBuffers;
+
+  std::mutex m_MeshedChunksMutex;
+  std::vector<MeshedChunk *> m_MeshedChunks;
+
+  // Meshes prontas que ainda não couberam no limite de envios por frame
+  std::vector<MeshedChunk *> m_MeshUploadQueue;
+
+  uint32_t m_LastMeshVersion;
+
+  CullingStats m_CullingStats;
+  RenderPassStats m_PassStats[DP_COUNT];
+
+  OcclusionBuffer m_OcclusionBuffer;
+  bool m_IsOcclusionCullingEnabled;
+
+  bool m_IsCaveCullingEnabled;
+
+  // Edições de blocos e voxels visitados para reconstruir as meshes afetadas por elas
+  uint64_t m_EditCount;
+  uint64_t m_EditVoxelsVisited;
+
+  int m_RenderDistance;
+
+  MeshingMode m_MeshingMode;
 
-  std::vector<glm::vec2> m_ChunksToUpdate;
+  glm::ivec2 m_CenterChunk;
+
+  // Chave única de um chunk a partir das suas coordenadas
+  static int64_t GetChunkKey(int chunkX, int chunkZ)
+  {
+    return (static_cast<int64_t>(chunkX) << 32) | static_cast<uint32_t>(chunkZ);
+  }
+
+  // Divide uma coordenada do mundo em coordenada do chunk e do bloco dentro do chunk
+  static void SplitCoordinate(int coordinate, int *chunk, int *block)
+  {
+    *chunk = coordinate >= 0 ? coordinate / WorldConstants::CHUNK_SIZE : (coordinate + 1) / WorldConstants::CHUNK_SIZE - 1;
+    *block = coordinate - *chunk * WorldConstants::CHUNK_SIZE;
+  }
 
   // Retorna os chunks vizinhos do chunk na posição passada
-  std::array<Chunk *, 4> GetNeighbors(glm::vec2 position)
+  std::array<Chunk *, 4> GetNeighbors(glm::ivec2 position)
   {
     int x = position.x;
     int z = position.y;
 
     std::array<Chunk *, 4> neighbors;
 
-    neighbors[0] = x - 1 >= 0 ? m_Chunks[x - 1][z] : NULL;
-    neighbors[1] = z + 1 < WorldConstants::CHUNKS_PER_AXIS ? m_Chunks[x][z + 1] : NULL;
-    neighbors[2] = x + 1 < WorldConstants::CHUNKS_PER_AXIS ? m_Chunks[x + 1][z] : NULL;
-    neighbors[3] = z - 1 >= 0 ? m_Chunks[x][z - 1] : NULL;
+    neighbors[0] = GetChunk(x - 1, z);
+    neighbors[1] = GetChunk(x, z + 1);
+    neighbors[2] = GetChunk(x + 1, z);
+    neighbors[3] = GetChunk(x, z - 1);
 
     return neighbors;
   }
 
+  void GenerateChunks(const std::vector<glm::ivec2> &positions);
+  void RequestChunk(glm::ivec2 position);
+
+  void AddChunk(Chunk *chunk);
+  void UnloadChunk(int64_t key);
+
+  // Ordem de desenho: menor distância ao chunk da câmera, com empate resolvido pelas coordenadas
+  bool IsDrawnBefore(const Chunk *a, const Chunk *b) const
+  {
+    glm::ivec2 da = glm::ivec2(a->GetChunkX(), a->GetChunkZ()) - m_DrawOrderChunk;
+    glm::ivec2 db = glm::ivec2(b->GetChunkX(), b->GetChunkZ()) - m_DrawOrderChunk;
+
+    int distanceA = da.x * da.x + da.y * da.y;
+    int distanceB = db.x * db.x + db.y * db.y;
+
+    if (distanceA != distanceB)
+      return distanceA < distanceB;
+
+    if (a->GetChunkX() != b->GetChunkX())
+      return a->GetChunkX() < b->GetChunkX();
+
+    return a->GetChunkZ() < b->GetChunkZ();
+  }
+
+  // Reordena os chunks e as seções se a câmera mudou de chunk ou de seção desde a última ordenação
+  void UpdateDrawOrder(glm::vec3 cameraPosition);
+
+  // Envia as seções visíveis de todos os chunks para o pass como um único pacote e contabiliza nas estatísticas do pass
+  // O estado de cada pass é definido pela fila, uma única vez
+  void SubmitPass(RenderQueue &queue, DrawPass pass, const DrawList &list);
+
+  bool IsInUnloadDistance(int chunkX, int chunkZ) const
+  {
+    int unloadDistance = m_RenderDistance + WorldConstants::UNLOAD_DISTANCE_MARGIN;
+
+    int dx = chunkX - m_CenterChunk.x;
+    int dz = chunkZ - m_CenterChunk.y;
+
+    return dx * dx + dz * dz <= unloadDistance * unloadDistance;
+  }
+
+  void UpdateLoadQueue();
+
+  // Marca seções de um chunk carregado para terem a mesh reconstruída
+  void MarkSectionsDirty(glm::ivec2 position, uint16_t sections, bool isPlayerEdit);
+
+  // Agenda a geração da mesh das seções de um chunk a partir de uma cópia dos seus blocos
+  void RequestChunkMesh(Chunk *chunk, uint16_t sections, bool isPriority);
+
+  // Envia para a GPU as meshes prontas: todas as prioritárias e até maxUploads das demais
+  void UploadMeshes(int maxUploads);
+
+  // Arena com o layout de CubeVertex
+  static VertexArena *CreateVertexArena();
+
+  // Percorre o grafo de visibilidade a partir da seção da câmera, marcando em cada chunk as seções
+  // dentro do frustum alcançadas; retorna false se a câmera não está dentro de um chunk carregado
+  bool FindReachableSections(glm::vec3 cameraPosition, const Frustum &frustum);
+
+  // Rasteriza no buffer de oclusão o casco do terreno e as seções totalmente opacas do chunk
+  void AddChunkOccluders(Chunk *chunk);
+
 public:
-  World(Shader *shader);
+  World(Shader *shader, glm::vec4 position, int renderDistance = WorldConstants::RENDER_DISTANCE);
   ~World();
 
   static bool RayCastCallback(World *data, glm::vec4 position);
 
-  void UpdateChunkMesh(glm::vec2 position);
+  // Carrega e descarrega chunks ao redor da posição
+  void Update(glm::vec4 position);
+
+  void SetRenderDistance(int renderDistance);
+  int GetRenderDistance() const { return m_RenderDistance; }
 
+  // Agenda a geração das meshes dos chunks na lista de atualização
   void UpdateMeshes();
-  void Draw(Camera *camera, glm::mat4 view, glm::mat4 projection);
+
+  // Espera todas as meshes agendadas e envia todas para a GPU
+  void FinishMeshes();
+
+  // Troca o algoritmo de meshing e reconstrói a mesh de todos os chunks carregados
+  void SetMeshingMode(MeshingMode mode);
+  MeshingMode GetMeshingMode() const { return m_MeshingMode; }
+
+  // Soma dos vértices das meshes de todos os chunks
+  size_t GetVertexCount() const;
+
+  // Memória das meshes de todos os chunks em bytes, com o vértice empacotado e sem empacotamento
+  size_t GetMeshMemoryUsage() const { return GetVertexCount() * sizeof(CubeVertex); }
+  size_t GetUnpackedMeshMemoryUsage() const { return GetVertexCount() * UNPACKED_VERTEX_SIZE; }
+
+  VertexArenaStats GetArenaStats() const { return m_VertexArena->GetStats(); }
+
+  // Desenha os chunks e as seções que estão dentro do frustum da câmera, são alcançáveis a partir dela
+  // e não estão escondidos pelo terreno
+  // Faz o culling e envia a geometria visível para a fila; view e projection só são usadas no culling
+  void Draw(RenderQueue &queue, Camera *camera, glm::mat4 view, glm::mat4 projection);
+
+  const CullingStats &GetCullingStats() const { return m_CullingStats; }
+  const RenderPassStats &GetPassStats(DrawPass pass) const { return m_PassStats[pass]; }
+
+  void SetOcclusionCulling(bool isEnabled) { m_IsOcclusionCullingEnabled = isEnabled; }
+  bool IsOcclusionCullingEnabled() const { return m_IsOcclusionCullingEnabled; }
+
+  void SetCaveCulling(bool isEnabled) { m_IsCaveCullingEnabled = isEnabled; }
+  bool IsCaveCullingEnabled() const { return m_IsCaveCullingEnabled; }
 
   void SetBlock(glm::vec3 position, int block);
   int GetBlock(glm::vec3 position);
 
   Chunk *GetChunk(int x, int z);
 
+  uint64_t GetEditCount() const { return m_EditCount; }
+  uint64_t GetEditVoxelsVisited() const { return m_EditVoxelsVisited; }
+
+  int GetLoadedChunkCount() const { return static_cast<int>(m_Chunks.size()); }
+
+  // Memória ocupada pelos blocos de todos os chunks, em bytes
+  size_t GetMemoryUsage() const;
+
   Texture *GetTextureAtlas() { return m_TextureAtlas; }
 };
 
-#endif
\ No newline at end of file
+#endif
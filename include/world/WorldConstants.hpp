@@ -7,13 +7,37 @@ namespace WorldConstants
   const int CHUNK_SIZE = 16;
   const int CHUNK_HEIGHT = 256;
 
+  const int SECTION_HEIGHT = 16;
+  const int SECTIONS_PER_CHUNK = CHUNK_HEIGHT / SECTION_HEIGHT;
+
   const int WATER_LEVEL = CHUNK_SIZE;
 
+  // Tamanho da ilha gerada pelo terreno, em chunks por eixo (o mundo em si não tem limites)
   const int CHUNKS_PER_AXIS = 16;
 
   const float WORLD_SIZE = static_cast<float>(WorldConstants::CHUNKS_PER_AXIS) * WorldConstants::CHUNK_SIZE;
 
   const int MIN_HEIGHT = 2;
+
+  // Raio de chunks carregados ao redor da câmera
+  const int RENDER_DISTANCE = 10;
+
+  // Margem extra antes de descarregar um chunk, evitando carregar e descarregar na borda do raio
+  const int UNLOAD_DISTANCE_MARGIN = 2;
+
+  // Quantidade máxima de chunks enviados para geração em segundo plano a cada frame
+  const int MAX_CHUNK_LOADS_PER_FRAME = 4;
+
+  // Quantidade máxima de meshes geradas em segundo plano enviadas à GPU a cada frame
+  // As meshes de blocos editados pelo jogador não entram nesse limite
+  const int MAX_MESH_UPLOADS_PER_FRAME = 8;
+
+  // Páginas iniciais da arena de vértices dos chunks (64 vértices cada); a arena dobra quando fica cheia
+  const int INITIAL_ARENA_PAGES = 4096;
+
+  // Recuo, em blocos, das caixas usadas como oclusores em relação aos blocos que elas representam,
+  // para que a superfície de um oclusor nunca esconda a própria mesh que coincide com ela
+  const float OCCLUDER_INSET = 0.1f;
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <iterator>
+
+#include "core/BufferAllocator.hpp"
+
+BufferAllocator::BufferAllocator(int capacity)
+    : m_Capacity(capacity),
+      m_Used(0)
+{
+  if (capacity > 0)
+    m_FreeBlocks[0] = capacity;
+}
+
+// Insere um bloco livre unindo-o aos blocos livres imediatamente antes e depois dele
+void BufferAllocator::AddFreeBlock(int offset, int size)
+{
+  auto next = m_FreeBlocks.lower_bound(offset);
+
+  if (next != m_FreeBlocks.end() && offset + size == next->first)
+  {
+    size += next->second;
+    next = m_FreeBlocks.erase(next);
+  }
+
+  if (next != m_FreeBlocks.begin())
+  {
+    auto previous = std::prev(next);
+
+    if (previous->first + previous->second == offset)
+    {
+      previous->second += size;
+      return;
+    }
+  }
+
+  m_FreeBlocks[offset] = size;
+}
+
+int BufferAllocator::Allocate(int size)
+{
+  if (size <= 0)
+    return INVALID;
+
+  // Best fit: o menor bloco que comporta a alocação, o de menor posição em caso de empate
+  auto best = m_FreeBlocks.end();
+
+  for (auto block = m_FreeBlocks.begin(); block != m_FreeBlocks.end(); ++block)
+  {
+    if (block->second >= size && (best == m_FreeBlocks.end() || block->second < best->second))
+      best = block;
+
+    if (best != m_FreeBlocks.end() && best->second == size)
+      break;
+  }
+
+  if (best == m_FreeBlocks.end())
+    return INVALID;
+
+  int offset = best->first;
+  int remaining = best->second - size;
+
+  m_FreeBlocks.erase(best);
+
+  if (remaining > 0)
+    m_FreeBlocks[offset + size] = remaining;
+
+  int handle;
+
+  if (m_FreeHandles.empty())
+  {
+    handle = static_cast<int>(m_Allocations.size());
+    m_Allocations.push_back(Allocation());
+  }
+  else
+  {
+    handle = m_FreeHandles.back();
+    m_FreeHandles.pop_back();
+  }
+
+  m_Allocations[handle] = {offset, size};
+  m_Used += size;
+
+  return handle;
+}
+
+void BufferAllocator::Free(int handle)
+{
+  Allocation &allocation = m_Allocations[handle];
+
+  AddFreeBlock(allocation.offset, allocation.size);
+
+  m_Used -= allocation.size;
+
+  allocation = {0, 0};
+  m_FreeHandles.push_back(handle);
+}
+
+void BufferAllocator::Grow(int capacity)
+{
+  if (capacity <= m_Capacity)
+    return;
+
+  int oldCapacity = m_Capacity;
+
+  m_Capacity = capacity;
+
+  AddFreeBlock(oldCapacity, capacity - oldCapacity);
+}
+
+std::vector<BufferAllocator::Move> BufferAllocator::Defragment()
+{
+  std::vector<int> handles;
+
+  for (size_t handle = 0; handle < m_Allocations.size(); handle++)
+    if (m_Allocations[handle].size > 0)
+      handles.push_back(static_cast<int>(handle));
+
+  std::sort(handles.begin(), handles.end(), [this](int a, int b)
+            { return m_Allocations[a].offset < m_Allocations[b].offset; });
+
+  std::vector<Move> moves;
+
+  int offset = 0;
+
+  for (int handle : handles)
+  {
+    Allocation &allocation = m_Allocations[handle];
+
+    if (allocation.offset != offset)
+    {
+      moves.push_back({handle, allocation.offset, offset, allocation.size});
+      allocation.offset = offset;
+    }
+
+    offset += allocation.size;
+  }
+
+  m_FreeBlocks.clear();
+
+  if (offset < m_Capacity)
+    m_FreeBlocks[offset] = m_Capacity - offset;
+
+  return moves;
+}
+
+int BufferAllocator::GetLargestFreeBlock() const
+{
+  int largest = 0;
+
+  for (auto &block : m_FreeBlocks)
+    largest = std::max(largest, block.second);
+
+  return largest;
+}
+
+float BufferAllocator::GetFragmentation() const
+{
+  int free = GetFree();
+
+  return free > 0 ? 1.0f - static_cast<float>(GetLargestFreeBlock()) / free : 0.0f;
+}
@@ -0,0 +1,32 @@
+#include "core/Frustum.hpp"
+
+// Cada plano é a soma ou a diferença da quarta linha da matriz com uma das outras três,
+// o que equivale aos testes -w <= x, y, z <= w feitos no clip space
+Frustum::Frustum(const glm::mat4 &viewProjection)
+{
+  // A GLM guarda as matrizes por coluna, então a linha i é (m[0][i], m[1][i], m[2][i], m[3][i])
+  glm::vec4 rows[4];
+
+  for (int i = 0; i < 4; i++)
+    rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+
+  for (int axis = 0; axis < 3; axis++)
+  {
+    m_Planes[axis * 2] = rows[3] + rows[axis];
+    m_Planes[axis * 2 + 1] = rows[3] - rows[axis];
+  }
+}
+
+bool Frustum::IsBoxVisible(const glm::vec3 &min, const glm::vec3 &max) const
+{
+  for (const glm::vec4 &plane : m_Planes)
+  {
+    // Vértice da caixa mais à frente na direção da normal do plano
+    glm::vec3 corner = glm::vec3(plane.x >= 0.0f ? max.x : min.x, plane.y >= 0.0f ? max.y : min.y, plane.z >= 0.0f ? max.z : min.z);
+
+    if (plane.x * corner.x + plane.y * corner.y + plane.z * corner.z + plane.w < 0.0f)
+      return false;
+  }
+
+  return true;
+}
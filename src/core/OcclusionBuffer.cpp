@@ -0,0 +1,279 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include <glm/common.hpp>
+#include <glm/vec2.hpp>
+
+#include "core/OcclusionBuffer.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OCCLUSION_USE_SSE
+#include <emmintrin.h>
+#endif
+
+// Profundidade de um pixel sem oclusor, atrás de tudo
+static const float EMPTY_DEPTH = 2.0f;
+
+// Menor w aceito ao recortar no plano near, evitando a divisão por valores próximos de zero
+static const float NEAR_W = 1e-3f;
+
+// Pixels em volta da tela que também recebem os oclusores, para o teste de uma caixa na borda da tela
+// poder exigir que o oclusor continue além dela
+static const int GUARD_BAND = 1;
+
+// Converte um ponto em NDC para coordenadas de pixel do buffer, com a tela dentro da guard band
+static glm::vec2 ToPixel(float x, float y)
+{
+  const int width = OcclusionBuffer::WIDTH - 2 * GUARD_BAND;
+  const int height = OcclusionBuffer::HEIGHT - 2 * GUARD_BAND;
+
+  return glm::vec2((x * 0.5f + 0.5f) * width + GUARD_BAND, (y * 0.5f + 0.5f) * height + GUARD_BAND);
+}
+
+OcclusionBuffer::OcclusionBuffer()
+    : m_Depth(WIDTH * HEIGHT, EMPTY_DEPTH),
+      m_ViewProjection(1.0f),
+      m_Eye(0.0f),
+      m_TriangleCount(0)
+{
+}
+
+void OcclusionBuffer::Clear(const glm::mat4 &viewProjection, const glm::vec3 &eye)
+{
+  std::fill(m_Depth.begin(), m_Depth.end(), EMPTY_DEPTH);
+
+  m_ViewProjection = viewProjection;
+  m_Eye = eye;
+  m_TriangleCount = 0;
+}
+
+// Rasteriza as até três faces da caixa voltadas para a câmera
+void OcclusionBuffer::AddOccluder(const glm::vec3 &min, const glm::vec3 &max)
+{
+  glm::vec4 corners[8];
+
+  for (int i = 0; i < 8; i++)
+    corners[i] = m_ViewProjection * glm::vec4(i & 1 ? max.x : min.x, i & 2 ? max.y : min.y, i & 4 ? max.z : min.z, 1.0f);
+
+  // Índices dos cantos de cada face: -x, +x, -y, +y, -z, +z
+  static const int FACES[6][4] = {{0, 2, 6, 4}, {1, 5, 7, 3}, {0, 4, 5, 1}, {2, 3, 7, 6}, {0, 1, 3, 2}, {4, 6, 7, 5}};
+
+  for (int axis = 0; axis < 3; axis++)
+  {
+    int face = -1;
+
+    if (m_Eye[axis] < min[axis])
+      face = axis * 2;
+    else if (m_Eye[axis] > max[axis])
+      face = axis * 2 + 1;
+
+    if (face < 0)
+      continue;
+
+    glm::vec4 quad[4] = {corners[FACES[face][0]], corners[FACES[face][1]], corners[FACES[face][2]], corners[FACES[face][3]]};
+
+    DrawQuad(quad);
+  }
+}
+
+void OcclusionBuffer::DrawQuad(const glm::vec4 corners[4])
+{
+  // Recorta o polígono no plano w = NEAR_W (Sutherland-Hodgman com um único plano)
+  glm::vec4 clipped[5];
+  int count = 0;
+
+  for (int i = 0; i < 4; i++)
+  {
+    const glm::vec4 &current = corners[i];
+    const glm::vec4 &next = corners[(i + 1) % 4];
+
+    bool isCurrentInside = current.w >= NEAR_W;
+    bool isNextInside = next.w >= NEAR_W;
+
+    if (isCurrentInside)
+      clipped[count++] = current;
+
+    if (isCurrentInside != isNextInside)
+    {
+      float t = (NEAR_W - current.w) / (next.w - current.w);
+      clipped[count++] = current + (next - current) * t;
+    }
+  }
+
+  if (count < 3)
+    return;
+
+  // Projeta para coordenadas de pixel, com a profundidade em NDC
+  glm::vec3 screen[5];
+
+  for (int i = 0; i < count; i++)
+  {
+    float inverseW = 1.0f / clipped[i].w;
+
+    screen[i] = glm::vec3(ToPixel(clipped[i].x * inverseW, clipped[i].y * inverseW), clipped[i].z * inverseW);
+  }
+
+  for (int i = 1; i + 1 < count; i++)
+    DrawTriangle(screen[0], screen[i], screen[i + 1]);
+}
+
+// Rasteriza um triângulo em coordenadas de pixel, guardando a menor profundidade nos pixels cujo centro ele cobre
+void OcclusionBuffer::DrawTriangle(glm::vec3 a, glm::vec3 b, glm::vec3 c)
+{
+  float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+
+  if (area == 0.0f)
+    return;
+
+  // Com a orientação anti-horária, o interior tem as três funções de aresta positivas
+  if (area < 0.0f)
+  {
+    std::swap(b, c);
+    area = -area;
+  }
+
+  int minX = std::max(0, static_cast<int>(floorf(std::min(a.x, std::min(b.x, c.x)))));
+  int maxX = std::min(WIDTH - 1, static_cast<int>(ceilf(std::max(a.x, std::max(b.x, c.x)))));
+  int minY = std::max(0, static_cast<int>(floorf(std::min(a.y, std::min(b.y, c.y)))));
+  int maxY = std::min(HEIGHT - 1, static_cast<int>(ceilf(std::max(a.y, std::max(b.y, c.y)))));
+
+  if (minX > maxX || minY > maxY)
+    return;
+
+  m_TriangleCount++;
+
+  // Funções de aresta e plano da profundidade na forma A * x + B * y + C
+  glm::vec3 edgeA = glm::vec3(a.y - b.y, b.y - c.y, c.y - a.y);
+  glm::vec3 edgeB = glm::vec3(b.x - a.x, c.x - b.x, a.x - c.x);
+  glm::vec3 edgeC = glm::vec3(a.x * b.y - a.y * b.x, b.x * c.y - b.y * c.x, c.x * a.y - c.y * a.x);
+
+  float depthA = ((b.y - c.y) * a.z + (c.y - a.y) * b.z + (a.y - b.y) * c.z) / area;
+  float depthB = ((c.x - b.x) * a.z + (a.x - c.x) * b.z + (b.x - a.x) * c.z) / area;
+  float depthC = a.z - depthA * a.x - depthB * a.y;
+
+  // Começa no grupo de 4 pixels alinhado que contém minX; pixels fora do triângulo são descartados pelas arestas
+  minX &= ~3;
+
+#ifdef OCCLUSION_USE_SSE
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+
+  for (int y = minY; y <= maxY; y++)
+  {
+    float centerY = y + 0.5f;
+
+    __m128 row0 = _mm_set1_ps(edgeB.x * centerY + edgeC.x);
+    __m128 row1 = _mm_set1_ps(edgeB.y * centerY + edgeC.y);
+    __m128 row2 = _mm_set1_ps(edgeB.z * centerY + edgeC.z);
+    __m128 rowDepth = _mm_set1_ps(depthB * centerY + depthC);
+
+    float *depthRow = &m_Depth[y * WIDTH];
+
+    for (int x = minX; x <= maxX; x += 4)
+    {
+      __m128 centerX = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), offsets);
+
+      __m128 edge0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA.x), centerX), row0);
+      __m128 edge1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA.y), centerX), row1);
+      __m128 edge2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA.z), centerX), row2);
+
+      __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(edge0, zero), _mm_cmpge_ps(edge1, zero)), _mm_cmpge_ps(edge2, zero));
+
+      if (_mm_movemask_ps(inside) == 0)
+        continue;
+
+      __m128 depth = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(depthA), centerX), rowDepth);
+      __m128 current = _mm_loadu_ps(&depthRow[x]);
+
+      __m128 nearest = _mm_min_ps(current, depth);
+
+      _mm_storeu_ps(&depthRow[x], _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+    }
+  }
+#else
+  for (int y = minY; y <= maxY; y++)
+  {
+    float centerY = y + 0.5f;
+
+    for (int x = minX; x <= maxX; x++)
+    {
+      float centerX = x + 0.5f;
+
+      bool isInside = edgeA.x * centerX + edgeB.x * centerY + edgeC.x >= 0.0f &&
+                      edgeA.y * centerX + edgeB.y * centerY + edgeC.y >= 0.0f &&
+                      edgeA.z * centerX + edgeB.z * centerY + edgeC.z >= 0.0f;
+
+      if (!isInside)
+        continue;
+
+      float &current = m_Depth[y * WIDTH + x];
+
+      current = std::min(current, depthA * centerX + depthB * centerY + depthC);
+    }
+  }
+#endif
+}
+
+bool OcclusionBuffer::IsBoxOccluded(const glm::vec3 &min, const glm::vec3 &max) const
+{
+  glm::vec2 screenMin = glm::vec2(FLT_MAX);
+  glm::vec2 screenMax = glm::vec2(-FLT_MAX);
+
+  float nearestDepth = EMPTY_DEPTH;
+
+  for (int i = 0; i < 8; i++)
+  {
+    glm::vec4 corner = m_ViewProjection * glm::vec4(i & 1 ? max.x : min.x, i & 2 ? max.y : min.y, i & 4 ? max.z : min.z, 1.0f);
+
+    if (corner.w < NEAR_W)
+      return false;
+
+    float inverseW = 1.0f / corner.w;
+
+    glm::vec2 screen = ToPixel(corner.x * inverseW, corner.y * inverseW);
+
+    screenMin = glm::min(screenMin, screen);
+    screenMax = glm::max(screenMax, screen);
+
+    nearestDepth = std::min(nearestDepth, corner.z * inverseW);
+  }
+
+  // Pixels tocados pelo retângulo da caixa na tela, com um pixel a mais em cada lado
+  // Os oclusores só cobrem os pixels cujo centro está dentro deles, então a borda de um oclusor pode passar
+  // por um pixel sem cobri-lo inteiro; exigir o pixel vizinho coberto garante que a borda está fora da caixa
+  int minX = std::max(0, static_cast<int>(floorf(screenMin.x)) - 1);
+  int maxX = std::min(WIDTH - 1, static_cast<int>(ceilf(screenMax.x)));
+  int minY = std::max(0, static_cast<int>(floorf(screenMin.y)) - 1);
+  int maxY = std::min(HEIGHT - 1, static_cast<int>(ceilf(screenMax.y)));
+
+  // Caixas fora da tela são responsabilidade do frustum culling
+  if (minX > maxX || minY > maxY)
+    return false;
+
+#ifdef OCCLUSION_USE_SSE
+  const __m128 boxDepth = _mm_set1_ps(nearestDepth);
+
+  for (int y = minY; y <= maxY; y++)
+  {
+    const float *depthRow = &m_Depth[y * WIDTH];
+
+    int x = minX;
+
+    for (; x + 3 <= maxX; x += 4)
+      if (_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(&depthRow[x]), boxDepth)) != 0)
+        return false;
+
+    for (; x <= maxX; x++)
+      if (depthRow[x] >= nearestDepth)
+        return false;
+  }
+#else
+  for (int y = minY; y <= maxY; y++)
+    for (int x = minX; x <= maxX; x++)
+      if (m_Depth[y * WIDTH + x] >= nearestDepth)
+        return false;
+#endif
+
+  return true;
+}
@@ -0,0 +1,293 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+
+#include "core/Profiler.hpp"
+
+namespace
+{
+  const std::chrono::steady_clock::time_point START = std::chrono::steady_clock::now();
+
+  // Limite de eventos de uma captura, para uma captura longa não crescer sem limite
+  const size_t MAX_TRACE_EVENTS = 1 << 20;
+
+  struct ProfileThread
+  {
+    std::unique_ptr<ProfileRing> ring;
+    std::string name;
+  };
+
+  struct TraceEvent
+  {
+    ProfileEvent event;
+    int thread;
+  };
+
+  // Durações recentes de uma zona, em nanossegundos, em uma janela circular
+  struct ZoneWindow
+  {
+    uint64_t durations[Profiler::WINDOW_SIZE];
+    int next;
+    int count;
+    int frameCalls;
+  };
+
+  std::atomic<bool> isProfilerEnabled(true);
+
+  // Protege só o registro de zonas e threads; a gravação dos eventos não trava
+  std::mutex registryMutex;
+  const char *zoneNames[Profiler::MAX_ZONES];
+  int zoneCount = 0;
+  std::vector<ProfileThread> threads;
+
+  thread_local ProfileRing *threadRing = nullptr;
+  thread_local int threadIndex = -1;
+
+  // Estado usado só pela thread principal, no Collect
+  ZoneWindow windows[Profiler::MAX_ZONES];
+  std::vector<ProfileEvent> collected;
+
+  std::vector<TraceEvent> trace;
+  int captureFrames = 0;
+  std::string capturePath;
+
+  // Registra a thread atual na primeira gravação
+  ProfileRing *GetThreadRing()
+  {
+    if (threadRing)
+      return threadRing;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    threadIndex = static_cast<int>(threads.size());
+    threads.push_back({std::unique_ptr<ProfileRing>(new ProfileRing()), "Thread " + std::to_string(threadIndex)});
+    threadRing = threads.back().ring.get();
+
+    return threadRing;
+  }
+
+  void WriteEscaped(FILE *file, const std::string &text)
+  {
+    for (char character : text)
+    {
+      if (character == '"' || character == '\\')
+        fputc('\\', file);
+
+      fputc(character, file);
+    }
+  }
+}
+
+ProfileRing::ProfileRing()
+    : m_Head(0),
+      m_Tail(0),
+      m_Dropped(0)
+{
+}
+
+void ProfileRing::Push(const ProfileEvent &event)
+{
+  uint32_t head = m_Head.load(std::memory_order_relaxed);
+
+  if (head - m_Tail.load(std::memory_order_acquire) == CAPACITY)
+  {
+    m_Dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  m_Events[head % CAPACITY] = event;
+
+  // Publica o evento só depois de escrito
+  m_Head.store(head + 1, std::memory_order_release);
+}
+
+void ProfileRing::Drain(std::vector<ProfileEvent> &events)
+{
+  uint32_t tail = m_Tail.load(std::memory_order_relaxed);
+  uint32_t head = m_Head.load(std::memory_order_acquire);
+
+  for (; tail != head; tail++)
+    events.push_back(m_Events[tail % CAPACITY]);
+
+  // Libera as posições lidas para a thread dona
+  m_Tail.store(tail, std::memory_order_release);
+}
+
+uint64_t Profiler::Now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - START).count();
+}
+
+int Profiler::RegisterZone(const char *name)
+{
+  std::lock_guard<std::mutex> lock(registryMutex);
+
+  if (zoneCount == MAX_ZONES)
+    return -1;
+
+  zoneNames[zoneCount] = name;
+
+  return zoneCount++;
+}
+
+void Profiler::Record(int zone, uint64_t begin, uint64_t end)
+{
+  if (zone < 0)
+    return;
+
+  GetThreadRing()->Push({zone, begin, end});
+}
+
+void Profiler::SetThreadName(const char *name)
+{
+  GetThreadRing();
+
+  std::lock_guard<std::mutex> lock(registryMutex);
+
+  threads[threadIndex].name = name;
+}
+
+void Profiler::SetEnabled(bool isEnabled)
+{
+  isProfilerEnabled.store(isEnabled, std::memory_order_relaxed);
+}
+
+bool Profiler::IsEnabled()
+{
+  return isProfilerEnabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::Collect()
+{
+  for (ZoneWindow &window : windows)
+    window.frameCalls = 0;
+
+  {
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    for (size_t thread = 0; thread < threads.size(); thread++)
+    {
+      collected.clear();
+      threads[thread].ring->Drain(collected);
+
+      for (const ProfileEvent &event : collected)
+      {
+        ZoneWindow &window = windows[event.zone];
+
+        window.durations[window.next] = event.end - event.begin;
+        window.next = (window.next + 1) % WINDOW_SIZE;
+        window.count = std::min(window.count + 1, WINDOW_SIZE);
+        window.frameCalls++;
+
+        if (captureFrames > 0 && trace.size() < MAX_TRACE_EVENTS)
+          trace.push_back({event, static_cast<int>(thread)});
+      }
+    }
+  }
+
+  if (captureFrames > 0 && --captureFrames == 0)
+  {
+    if (WriteChromeTrace(capturePath))
+      printf("Trace: %d events written to %s \n", (int)trace.size(), capturePath.c_str());
+    else
+      fprintf(stderr, "ERROR: Could not write trace to %s\n", capturePath.c_str());
+
+    trace.clear();
+  }
+}
+
+void Profiler::StartCapture(int frames, const std::string &path)
+{
+  trace.clear();
+
+  captureFrames = frames;
+  capturePath = path;
+}
+
+bool Profiler::IsCapturing()
+{
+  return captureFrames > 0;
+}
+
+bool Profiler::WriteChromeTrace(const std::string &path)
+{
+  FILE *file = fopen(path.c_str(), "w");
+
+  if (!file)
+    return false;
+
+  std::lock_guard<std::mutex> lock(registryMutex);
+
+  fprintf(file, "{\"traceEvents\":[");
+
+  const char *separator = "\n";
+
+  for (size_t thread = 0; thread < threads.size(); thread++)
+  {
+    fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"", separator, (int)thread);
+    WriteEscaped(file, threads[thread].name);
+    fprintf(file, "\"}}");
+
+    separator = ",\n";
+  }
+
+  // Eventos completos ("X"), com início e duração em microssegundos
+  for (const TraceEvent &traceEvent : trace)
+  {
+    fprintf(file, "%s{\"name\":\"", separator);
+    WriteEscaped(file, zoneNames[traceEvent.event.zone]);
+    fprintf(file, "\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", traceEvent.thread, traceEvent.event.begin / 1000.0, (traceEvent.event.end - traceEvent.event.begin) / 1000.0);
+
+    separator = ",\n";
+  }
+
+  fprintf(file, "\n]}\n");
+
+  return fclose(file) == 0;
+}
+
+std::vector<ZoneStats> Profiler::GetZoneStats()
+{
+  std::vector<ZoneStats> stats;
+  std::vector<uint64_t> durations;
+
+  std::lock_guard<std::mutex> lock(registryMutex);
+
+  for (int zone = 0; zone < zoneCount; zone++)
+  {
+    const ZoneWindow &window = windows[zone];
+
+    if (window.count == 0)
+      continue;
+
+    durations.assign(window.durations, window.durations + window.count);
+    std::sort(durations.begin(), durations.end());
+
+    // Percentil pelo posto mais próximo
+    auto percentile = [&durations](float fraction)
+    {
+      int rank = static_cast<int>(std::ceil(fraction * durations.size())) - 1;
+
+      return durations[std::max(rank, 0)] / 1000000.0f;
+    };
+
+    stats.push_back({zoneNames[zone], window.frameCalls, window.count, percentile(0.50f), percentile(0.95f), percentile(0.99f)});
+  }
+
+  return stats;
+}
+
+uint32_t Profiler::GetDroppedEvents()
+{
+  std::lock_guard<std::mutex> lock(registryMutex);
+
+  uint32_t dropped = 0;
+
+  for (const ProfileThread &thread : threads)
+    dropped += thread.ring->GetDropped();
+
+  return dropped;
+}
@@ -0,0 +1,92 @@
+#include <algorithm>
+
+#include "core/ThreadPool.hpp"
+#include "core/Profiler.hpp"
+
+// Inicializa as threads de trabalho
+ThreadPool::ThreadPool(int threadCount)
+    : m_ActiveJobs(0),
+      m_IsStopping(false)
+{
+  if (threadCount <= 0)
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+  for (int i = 0; i < threadCount; i++)
+    m_Workers.emplace_back(&ThreadPool::WorkerLoop, this);
+}
+
+// Descarta as tarefas que ainda não começaram e espera as threads terminarem
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    m_Jobs.clear();
+    m_PriorityJobs.clear();
+    m_IsStopping = true;
+  }
+
+  m_JobAvailable.notify_all();
+
+  for (auto &worker : m_Workers)
+    worker.join();
+}
+
+void ThreadPool::Submit(JobType job, bool isPriority)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if (isPriority)
+      m_PriorityJobs.push_back(std::move(job));
+    else
+      m_Jobs.push_back(std::move(job));
+  }
+
+  m_JobAvailable.notify_one();
+}
+
+void ThreadPool::Wait()
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+
+  m_JobsFinished.wait(lock, [this]()
+                      { return m_Jobs.empty() && m_PriorityJobs.empty() && m_ActiveJobs == 0; });
+}
+
+// Executa tarefas da fila até o pool ser destruído
+void ThreadPool::WorkerLoop()
+{
+  Profiler::SetThreadName("Worker");
+
+  while (true)
+  {
+    JobType job;
+
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+
+      m_JobAvailable.wait(lock, [this]()
+                          { return m_IsStopping || !m_Jobs.empty() || !m_PriorityJobs.empty(); });
+
+      if (m_IsStopping)
+        return;
+
+      std::deque<JobType> &jobs = m_PriorityJobs.empty() ? m_Jobs : m_PriorityJobs;
+
+      job = std::move(jobs.front());
+      jobs.pop_front();
+
+      m_ActiveJobs++;
+    }
+
+    job();
+
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_ActiveJobs--;
+    }
+
+    m_JobsFinished.notify_all();
+  }
+}
@@ -0,0 +1,298 @@
+#include "core.h"
+
+#include "engine/GLState.hpp"
+
+unsigned int GLState::program = 0;
+unsigned int GLState::vertexArray = 0;
+unsigned int GLState::buffers[BT_COUNT] = {};
+unsigned int GLState::uniformBindings[MAX_UNIFORM_BINDINGS] = {};
+
+std::unordered_map<unsigned int, unsigned int> GLState::elementBuffers;
+
+unsigned int GLState::activeTexture = 0;
+unsigned int GLState::textures[MAX_TEXTURE_UNITS][TT_COUNT] = {};
+
+unsigned int GLState::capabilities[CAP_COUNT] = {GL_FALSE, GL_FALSE, GL_FALSE};
+unsigned int GLState::blendSource = GL_ONE;
+unsigned int GLState::blendDestination = GL_ZERO;
+unsigned int GLState::polygonMode = GL_FILL;
+
+GLStateStats GLState::stats = {};
+
+bool GLState::Update(unsigned int &cached, unsigned int value)
+{
+  if (cached == value)
+  {
+    stats.elided++;
+    return false;
+  }
+
+  cached = value;
+  stats.issued++;
+
+  return true;
+}
+
+int GLState::GetBufferTarget(unsigned int target)
+{
+  switch (target)
+  {
+  case GL_ARRAY_BUFFER:
+    return BT_ARRAY;
+  case GL_UNIFORM_BUFFER:
+    return BT_UNIFORM;
+  case GL_TEXTURE_BUFFER:
+    return BT_TEXTURE;
+  case GL_COPY_READ_BUFFER:
+    return BT_COPY_READ;
+  case GL_COPY_WRITE_BUFFER:
+    return BT_COPY_WRITE;
+  default:
+    return -1;
+  }
+}
+
+int GLState::GetTextureTarget(unsigned int target)
+{
+  switch (target)
+  {
+  case GL_TEXTURE_2D:
+    return TT_2D;
+  case GL_TEXTURE_BUFFER:
+    return TT_BUFFER;
+  default:
+    return -1;
+  }
+}
+
+int GLState::GetCapability(unsigned int capability)
+{
+  switch (capability)
+  {
+  case GL_BLEND:
+    return CAP_BLEND;
+  case GL_DEPTH_TEST:
+    return CAP_DEPTH_TEST;
+  case GL_CULL_FACE:
+    return CAP_CULL_FACE;
+  default:
+    return -1;
+  }
+}
+
+void GLState::Invalidate()
+{
+  program = UNKNOWN;
+  vertexArray = UNKNOWN;
+
+  for (unsigned int &buffer : buffers)
+    buffer = UNKNOWN;
+
+  for (unsigned int &binding : uniformBindings)
+    binding = UNKNOWN;
+
+  elementBuffers.clear();
+
+  activeTexture = UNKNOWN;
+
+  for (auto &unit : textures)
+    for (unsigned int &texture : unit)
+      texture = UNKNOWN;
+
+  for (unsigned int &capability : capabilities)
+    capability = UNKNOWN;
+
+  blendSource = UNKNOWN;
+  blendDestination = UNKNOWN;
+  polygonMode = UNKNOWN;
+}
+
+void GLState::UseProgram(unsigned int program)
+{
+  if (Update(GLState::program, program))
+    glUseProgram(program);
+}
+
+void GLState::BindVertexArray(unsigned int vertexArray)
+{
+  if (Update(GLState::vertexArray, vertexArray))
+    glBindVertexArray(vertexArray);
+}
+
+void GLState::BindBuffer(unsigned int target, unsigned int buffer)
+{
+  if (target == GL_ELEMENT_ARRAY_BUFFER)
+  {
+    // Um VAO novo ainda não tem element array buffer
+    auto elementBuffer = elementBuffers.emplace(vertexArray, vertexArray == UNKNOWN ? UNKNOWN : 0).first;
+
+    if (Update(elementBuffer->second, buffer))
+      glBindBuffer(target, buffer);
+
+    return;
+  }
+
+  int index = GetBufferTarget(target);
+
+  if (index == -1)
+  {
+    stats.issued++;
+    glBindBuffer(target, buffer);
+    return;
+  }
+
+  if (Update(buffers[index], buffer))
+    glBindBuffer(target, buffer);
+}
+
+void GLState::BindBufferBase(unsigned int target, unsigned int index, unsigned int buffer)
+{
+  if (target != GL_UNIFORM_BUFFER || index >= MAX_UNIFORM_BINDINGS)
+  {
+    stats.issued++;
+    glBindBufferBase(target, index, buffer);
+    return;
+  }
+
+  // glBindBufferBase também muda a ligação genérica do alvo, então só é descartado se as duas já estão certas
+  if (uniformBindings[index] == buffer && buffers[BT_UNIFORM] == buffer)
+  {
+    stats.elided++;
+    return;
+  }
+
+  uniformBindings[index] = buffer;
+  buffers[BT_UNIFORM] = buffer;
+
+  stats.issued++;
+  glBindBufferBase(target, index, buffer);
+}
+
+void GLState::SetActiveTexture(unsigned int unit)
+{
+  if (Update(activeTexture, unit))
+    glActiveTexture(GL_TEXTURE0 + unit);
+}
+
+void GLState::BindTexture(unsigned int unit, unsigned int target, unsigned int texture)
+{
+  int index = GetTextureTarget(target);
+
+  if (index == -1 || unit >= MAX_TEXTURE_UNITS)
+  {
+    SetActiveTexture(unit);
+
+    stats.issued++;
+    glBindTexture(target, texture);
+    return;
+  }
+
+  // A unidade ativa só precisa mudar se a ligação dela vai mudar
+  if (textures[unit][index] == texture)
+  {
+    stats.elided++;
+    return;
+  }
+
+  SetActiveTexture(unit);
+
+  Update(textures[unit][index], texture);
+  glBindTexture(target, texture);
+}
+
+void GLState::SetEnabled(unsigned int capability, bool isEnabled)
+{
+  int index = GetCapability(capability);
+
+  if (index == -1)
+    stats.issued++;
+  else if (!Update(capabilities[index], isEnabled ? GL_TRUE : GL_FALSE))
+    return;
+
+  if (isEnabled)
+    glEnable(capability);
+  else
+    glDisable(capability);
+}
+
+void GLState::BlendFunc(unsigned int source, unsigned int destination)
+{
+  if (blendSource == source && blendDestination == destination)
+  {
+    stats.elided++;
+    return;
+  }
+
+  blendSource = source;
+  blendDestination = destination;
+
+  stats.issued++;
+  glBlendFunc(source, destination);
+}
+
+void GLState::PolygonMode(unsigned int mode)
+{
+  if (Update(polygonMode, mode))
+    glPolygonMode(GL_FRONT_AND_BACK, mode);
+}
+
+unsigned int GLState::GetPolygonMode()
+{
+  // Só consulta o driver depois de Invalidate, pois glGet força uma sincronização
+  if (polygonMode == UNKNOWN)
+  {
+    GLint mode;
+    glGetIntegerv(GL_POLYGON_MODE, &mode);
+
+    polygonMode = mode;
+  }
+
+  return polygonMode;
+}
+
+void GLState::DeleteProgram(unsigned int program)
+{
+  glDeleteProgram(program);
+
+  // O programa em uso continua ativo até outro ser usado, mas o nome pode ser reutilizado
+  if (GLState::program == program)
+    GLState::program = UNKNOWN;
+}
+
+void GLState::DeleteVertexArray(unsigned int vertexArray)
+{
+  glDeleteVertexArrays(1, &vertexArray);
+
+  elementBuffers.erase(vertexArray);
+
+  if (GLState::vertexArray == vertexArray)
+    GLState::vertexArray = 0;
+}
+
+void GLState::DeleteBuffer(unsigned int buffer)
+{
+  glDeleteBuffers(1, &buffer);
+
+  for (unsigned int &bound : buffers)
+    if (bound == buffer)
+      bound = 0;
+
+  for (unsigned int &binding : uniformBindings)
+    if (binding == buffer)
+      binding = 0;
+
+  // Só o VAO atual perde a ligação; os outros continuam com o buffer antigo, que não pode ser confundido com um novo
+  for (auto &elementBuffer : elementBuffers)
+    if (elementBuffer.second == buffer)
+      elementBuffer.second = elementBuffer.first == vertexArray ? 0 : UNKNOWN;
+}
+
+void GLState::DeleteTexture(unsigned int texture)
+{
+  glDeleteTextures(1, &texture);
+
+  for (auto &unit : textures)
+    for (unsigned int &bound : unit)
+      if (bound == texture)
+        bound = 0;
+}
@@ -1,6 +1,7 @@
 #include "core.h"
 
 #include "engine/IndexBuffer.hpp"
+#include "engine/GLState.hpp"
 
 #include "engine/Renderer.hpp"
 
@@ -9,21 +10,21 @@ IndexBuffer::IndexBuffer(const unsigned int *data, unsigned int count)
     : m_Count(count)
 {
   glGenBuffers(1, &m_RendererId);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererId);
+  GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererId);
   glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), data, GL_STATIC_DRAW);
 }
 
 IndexBuffer::~IndexBuffer()
 {
-  glDeleteBuffers(1, &m_RendererId);
+  GLState::DeleteBuffer(m_RendererId);
 }
 
 void IndexBuffer::Bind() const
 {
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererId);
+  GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererId);
 }
 
 void IndexBuffer::Unbind() const
 {
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+  GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
@@ -0,0 +1,600 @@
+#include <cstring>
+#include <unordered_map>
+
+#include "core.h"
+
+#include "engine/NullBackend.hpp"
+#include "engine/GLState.hpp"
+
+namespace
+{
+  NullBackendStats stats = NullBackendStats();
+
+  // Nomes de todos os tipos de objeto saem do mesmo contador
+  GLuint nextName = 1;
+
+  // Cada consulta recebe uma localização nova, já que os valores nunca são lidos
+  GLint nextUniformLocation = 0;
+
+  std::unordered_map<GLuint, GLsizeiptr> bufferSizes;
+  std::unordered_map<GLuint, long> textureSizes;
+
+  std::unordered_map<GLenum, GLuint> boundBuffers;
+  GLuint boundVertexArray = 0;
+
+  // O element array buffer faz parte do estado do VAO
+  std::unordered_map<GLuint, GLuint> elementBuffers;
+
+  GLuint activeTextureUnit = 0;
+  std::unordered_map<GLuint, GLuint> boundTextures; // GL_TEXTURE_2D por unidade
+
+  void GenNames(GLsizei n, GLuint *names, int &liveCount)
+  {
+    for (int i = 0; i < n; i++)
+      names[i] = nextName++;
+
+    liveCount += n;
+  }
+
+  GLuint GetBoundBuffer(GLenum target)
+  {
+    auto buffer = boundBuffers.find(target);
+
+    return buffer != boundBuffers.end() ? buffer->second : 0;
+  }
+
+  // Recursos
+
+  void APIENTRY GenBuffers(GLsizei n, GLuint *buffers)
+  {
+    stats.calls++;
+    GenNames(n, buffers, stats.buffers);
+  }
+
+  void APIENTRY DeleteBuffers(GLsizei n, const GLuint *buffers)
+  {
+    stats.calls++;
+
+    for (int i = 0; i < n; i++)
+    {
+      auto buffer = bufferSizes.find(buffers[i]);
+
+      if (buffers[i] == 0)
+        continue;
+
+      if (buffer != bufferSizes.end())
+      {
+        stats.bufferBytes -= buffer->second;
+        bufferSizes.erase(buffer);
+      }
+
+      stats.buffers--;
+    }
+  }
+
+  void APIENTRY GenVertexArrays(GLsizei n, GLuint *arrays)
+  {
+    stats.calls++;
+    GenNames(n, arrays, stats.vertexArrays);
+  }
+
+  void APIENTRY DeleteVertexArrays(GLsizei n, const GLuint *arrays)
+  {
+    stats.calls++;
+
+    for (int i = 0; i < n; i++)
+    {
+      if (arrays[i] == 0)
+        continue;
+
+      elementBuffers.erase(arrays[i]);
+      stats.vertexArrays--;
+    }
+  }
+
+  void APIENTRY GenTextures(GLsizei n, GLuint *textures)
+  {
+    stats.calls++;
+    GenNames(n, textures, stats.textures);
+  }
+
+  void APIENTRY DeleteTextures(GLsizei n, const GLuint *textures)
+  {
+    stats.calls++;
+
+    for (int i = 0; i < n; i++)
+    {
+      auto texture = textureSizes.find(textures[i]);
+
+      if (textures[i] == 0)
+        continue;
+
+      if (texture != textureSizes.end())
+      {
+        stats.textureBytes -= texture->second;
+        textureSizes.erase(texture);
+      }
+
+      stats.textures--;
+    }
+  }
+
+  // Buffers
+
+  void APIENTRY BindBuffer(GLenum target, GLuint buffer)
+  {
+    stats.calls++;
+
+    boundBuffers[target] = buffer;
+
+    if (target == GL_ELEMENT_ARRAY_BUFFER)
+      elementBuffers[boundVertexArray] = buffer;
+  }
+
+  void APIENTRY BindBufferBase(GLenum target, GLuint index, GLuint buffer)
+  {
+    stats.calls++;
+
+    // Também liga o buffer no ponto genérico do alvo
+    boundBuffers[target] = buffer;
+  }
+
+  void APIENTRY BufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage)
+  {
+    stats.calls++;
+
+    GLsizeiptr &bufferSize = bufferSizes[GetBoundBuffer(target)];
+
+    stats.bufferBytes += size - bufferSize;
+    bufferSize = size;
+
+    if (data)
+      stats.uploadedBytes += size;
+  }
+
+  void APIENTRY BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data)
+  {
+    stats.calls++;
+    stats.uploadedBytes += size;
+  }
+
+  void APIENTRY CopyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size)
+  {
+    stats.calls++;
+    stats.copiedBytes += size;
+  }
+
+  // Vertex arrays
+
+  void APIENTRY BindVertexArray(GLuint array)
+  {
+    stats.calls++;
+
+    boundVertexArray = array;
+    boundBuffers[GL_ELEMENT_ARRAY_BUFFER] = elementBuffers[array];
+  }
+
+  void APIENTRY EnableVertexAttribArray(GLuint index)
+  {
+    stats.calls++;
+  }
+
+  void APIENTRY VertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer)
+  {
+    stats.calls++;
+  }
+
+  void APIENTRY VertexAttribIPointer(GLuint index, GLint size, GLenum type, GLsizei stride, const void *pointer)
+  {
+    stats.calls++;
+  }
+
+  // Texturas
+
+  void APIENTRY ActiveTexture(GLenum texture)
+  {
+    stats.calls++;
+    activeTextureUnit = texture - GL_TEXTURE0;
+  }
+
+  void APIENTRY BindTexture(GLenum target, GLuint texture)
+  {
+    stats.calls++;
+
+    if (target == GL_TEXTURE_2D)
+      boundTextures[activeTextureUnit] = texture;
+  }
+
+  void APIENTRY TexParameteri(GLenum target, GLenum name, GLint param)
+  {
+    stats.calls++;
+  }
+
+  void APIENTRY TexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels)
+  {
+    stats.calls++;
+
+    int bytesPerPixel = internalFormat == GL_RGB8 || internalFormat == GL_RGB ? 3 : 4;
+    long size = static_cast<long>(width) * height * bytesPerPixel;
+
+    long &textureSize = textureSizes[boundTextures[activeTextureUnit]];
+
+    stats.textureBytes += size - textureSize;
+    textureSize = size;
+
+    if (pixels)
+      stats.uploadedBytes += size;
+  }
+
+  // Os bytes já são contados no buffer
+  void APIENTRY TexBuffer(GLenum target, GLenum internalFormat, GLuint buffer)
+  {
+    stats.calls++;
+  }
+
+  // Shaders
+
+  GLuint APIENTRY CreateProgram()
+  {
+    stats.calls++;
+    stats.programs++;
+
+    return nextName++;
+  }
+
+  void APIENTRY DeleteProgram(GLuint program)
+  {
+    stats.calls++;
+
+    if (program != 0)
+      stats.programs--;
+  }
+
+  void APIENTRY UseProgram(GLuint program)
+  {
+    stats.calls++;
+  }
+
+  GLuint APIENTRY CreateShader(GLenum type)
+  {
+    stats.calls++;
+    return nextName++;
+  }
+
+  void APIENTRY DeleteShader(GLuint shader)
+  {
+    stats.calls++;
+  }
+
+  void APIENTRY ShaderSource(GLuint shader, GLsizei count, const GLchar *const *string, const GLint *length)
+  {
+    stats.calls++;
+  }
+
+  void APIENTRY CompileShader(GLuint shader)
+  {
+    stats.calls++;
+  }
+
+  void APIENTRY AttachShader(GLuint program, GLuint shader)
+  {
+    stats.calls++;
+  }
+
+  void APIENTRY LinkProgram(GLuint program)
+  {
+    stats.calls++;
+  }
+
+  void APIENTRY ValidateProgram(GLuint program)
+  {
+    stats.calls++;
+  }
+
+  // Toda compilação é bem sucedida e não há log
+  void APIENTRY GetShaderiv(GLuint shader, GLenum name, GLint *params)
+  {
+    stats.calls++;
+    *params = name == GL_COMPILE_STATUS ? GL_TRUE : 0;
+  }
+
+  void APIENTRY GetShaderInfoLog(GLuint shader, GLsizei bufferSize, GLsizei *length, GLchar *infoLog)
+  {
+    stats.calls++;
+
+    if (length)
+      *length = 0;
+
+    if (bufferSize > 0)
+      infoLog[0] = '\0';
+  }
+
+  // Nenhum uniform ativo é listado, então o Shader resolve cada um pelo nome na primeira consulta
+  void APIENTRY GetProgramiv(GLuint program, GLenum name, GLint *params)
+  {
+    stats.calls++;
+    *params = name == GL_LINK_STATUS || name == GL_VALIDATE_STATUS ? GL_TRUE : 0;
+  }
+
+  void APIENTRY GetActiveUniform(GLuint program, GLuint index, GLsizei bufferSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name)
+  {
+    stats.calls++;
+
+    *length = 0;
+    *size = 0;
+    *type = 0;
+
+    if (bufferSize > 0)
+      name[0] = '\0';
+  }
+
+  GLint APIENTRY GetUniformLocation(GLuint program, const GLchar *name)
+  {
+    stats.calls++;
+    return nextUniformLocation++;
+  }
+
+  GLuint APIENTRY GetUniformBlockIndex(GLuint program, const GLchar *name)
+  {
+    stats.calls++;
+    return 0;
+  }
+
+  void APIENTRY UniformBlockBinding(GLuint program, GLuint blockIndex, GLuint blockBinding)
+  {
+    stats.calls++;
+  }
+
+  void APIENTRY Uniform1i(GLint location, GLint v0)
+  {
+    stats.calls++;
+  }
+
+  void APIENTRY Uniform1f(GLint location, GLfloat v0)
+  {
+    stats.calls++;
+  }
+
+  void APIENTRY Uniform2f(GLint location, GLfloat v0, GLfloat v1)
+  {
+    stats.calls++;
+  }
+
+  void APIENTRY Uniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
+  {
+    stats.calls++;
+  }
+
+  void APIENTRY UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+  {
+    stats.calls++;
+  }
+
+  // Estado fixo
+
+  void APIENTRY Enable(GLenum capability)
+  {
+    stats.calls++;
+  }
+
+  void APIENTRY Disable(GLenum capability)
+  {
+    stats.calls++;
+  }
+
+  void APIENTRY BlendFunc(GLenum source, GLenum destination)
+  {
+    stats.calls++;
+  }
+
+  void APIENTRY PolygonMode(GLenum face, GLenum mode)
+  {
+    stats.calls++;
+  }
+
+  void APIENTRY Viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+  {
+    stats.calls++;
+  }
+
+  void APIENTRY ClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+  {
+    stats.calls++;
+  }
+
+  void APIENTRY Clear(GLbitfield mask)
+  {
+    stats.calls++;
+  }
+
+  // Consultas
+
+  void APIENTRY GetIntegerv(GLenum name, GLint *data)
+  {
+    stats.calls++;
+
+    if (name == GL_POLYGON_MODE)
+    {
+      data[0] = GL_FILL;
+      data[1] = GL_FILL;
+    }
+    else if (name == GL_NUM_EXTENSIONS)
+      data[0] = 1;
+    else
+      data[0] = 0;
+  }
+
+  // O glad lê a versão daqui para decidir quais funções carregar
+  const GLubyte *APIENTRY GetString(GLenum name)
+  {
+    stats.calls++;
+
+    const char *value = "";
+
+    switch (name)
+    {
+    case GL_VENDOR:
+      value = "Ourcraft";
+      break;
+    case GL_RENDERER:
+      value = "Null backend";
+      break;
+    case GL_VERSION:
+      value = "3.3 Null";
+      break;
+    case GL_SHADING_LANGUAGE_VERSION:
+      value = "3.30";
+      break;
+    }
+
+    return reinterpret_cast<const GLubyte *>(value);
+  }
+
+  // O glad falha com uma lista de extensões vazia, então o backend anuncia uma extensão própria
+  const GLubyte *APIENTRY GetStringi(GLenum name, GLuint index)
+  {
+    stats.calls++;
+    return reinterpret_cast<const GLubyte *>(name == GL_EXTENSIONS && index == 0 ? "GL_OURCRAFT_null_backend" : "");
+  }
+
+  GLenum APIENTRY GetError()
+  {
+    stats.calls++;
+    return GL_NO_ERROR;
+  }
+
+  // Desenhos
+
+  void APIENTRY DrawArrays(GLenum mode, GLint first, GLsizei count)
+  {
+    stats.calls++;
+    stats.drawCalls++;
+    stats.drawnVertices += count;
+  }
+
+  void APIENTRY DrawElements(GLenum mode, GLsizei count, GLenum type, const void *indices)
+  {
+    stats.calls++;
+    stats.drawCalls++;
+    stats.drawnVertices += count;
+  }
+
+  void APIENTRY MultiDrawArrays(GLenum mode, const GLint *first, const GLsizei *count, GLsizei drawCount)
+  {
+    stats.calls++;
+    stats.drawCalls++;
+
+    for (int i = 0; i < drawCount; i++)
+      stats.drawnVertices += count[i];
+  }
+
+  struct NullFunction
+  {
+    const char *name;
+    void *proc;
+  };
+
+#define NULL_FUNCTION(name, function) {name, reinterpret_cast<void *>(&function)}
+
+  const NullFunction FUNCTIONS[] = {
+      NULL_FUNCTION("glGenBuffers", GenBuffers),
+      NULL_FUNCTION("glDeleteBuffers", DeleteBuffers),
+      NULL_FUNCTION("glGenVertexArrays", GenVertexArrays),
+      NULL_FUNCTION("glDeleteVertexArrays", DeleteVertexArrays),
+      NULL_FUNCTION("glGenTextures", GenTextures),
+      NULL_FUNCTION("glDeleteTextures", DeleteTextures),
+      NULL_FUNCTION("glBindBuffer", BindBuffer),
+      NULL_FUNCTION("glBindBufferBase", BindBufferBase),
+      NULL_FUNCTION("glBufferData", BufferData),
+      NULL_FUNCTION("glBufferSubData", BufferSubData),
+      NULL_FUNCTION("glCopyBufferSubData", CopyBufferSubData),
+      NULL_FUNCTION("glBindVertexArray", BindVertexArray),
+      NULL_FUNCTION("glEnableVertexAttribArray", EnableVertexAttribArray),
+      NULL_FUNCTION("glVertexAttribPointer", VertexAttribPointer),
+      NULL_FUNCTION("glVertexAttribIPointer", VertexAttribIPointer),
+      NULL_FUNCTION("glActiveTexture", ActiveTexture),
+      NULL_FUNCTION("glBindTexture", BindTexture),
+      NULL_FUNCTION("glTexParameteri", TexParameteri),
+      NULL_FUNCTION("glTexImage2D", TexImage2D),
+      NULL_FUNCTION("glTexBuffer", TexBuffer),
+      NULL_FUNCTION("glCreateProgram", CreateProgram),
+      NULL_FUNCTION("glDeleteProgram", DeleteProgram),
+      NULL_FUNCTION("glUseProgram", UseProgram),
+      NULL_FUNCTION("glCreateShader", CreateShader),
+      NULL_FUNCTION("glDeleteShader", DeleteShader),
+      NULL_FUNCTION("glShaderSource", ShaderSource),
+      NULL_FUNCTION("glCompileShader", CompileShader),
+      NULL_FUNCTION("glAttachShader", AttachShader),
+      NULL_FUNCTION("glLinkProgram", LinkProgram),
+      NULL_FUNCTION("glValidateProgram", ValidateProgram),
+      NULL_FUNCTION("glGetShaderiv", GetShaderiv),
+      NULL_FUNCTION("glGetShaderInfoLog", GetShaderInfoLog),
+      NULL_FUNCTION("glGetProgramiv", GetProgramiv),
+      NULL_FUNCTION("glGetActiveUniform", GetActiveUniform),
+      NULL_FUNCTION("glGetUniformLocation", GetUniformLocation),
+      NULL_FUNCTION("glGetUniformBlockIndex", GetUniformBlockIndex),
+      NULL_FUNCTION("glUniformBlockBinding", UniformBlockBinding),
+      NULL_FUNCTION("glUniform1i", Uniform1i),
+      NULL_FUNCTION("glUniform1f", Uniform1f),
+      NULL_FUNCTION("glUniform2f", Uniform2f),
+      NULL_FUNCTION("glUniform4f", Uniform4f),
+      NULL_FUNCTION("glUniformMatrix4fv", UniformMatrix4fv),
+      NULL_FUNCTION("glEnable", Enable),
+      NULL_FUNCTION("glDisable", Disable),
+      NULL_FUNCTION("glBlendFunc", BlendFunc),
+      NULL_FUNCTION("glPolygonMode", PolygonMode),
+      NULL_FUNCTION("glViewport", Viewport),
+      NULL_FUNCTION("glClearColor", ClearColor),
+      NULL_FUNCTION("glClear", Clear),
+      NULL_FUNCTION("glGetIntegerv", GetIntegerv),
+      NULL_FUNCTION("glGetString", GetString),
+      NULL_FUNCTION("glGetStringi", GetStringi),
+      NULL_FUNCTION("glGetError", GetError),
+      NULL_FUNCTION("glDrawArrays", DrawArrays),
+      NULL_FUNCTION("glDrawElements", DrawElements),
+      NULL_FUNCTION("glMultiDrawArrays", MultiDrawArrays),
+  };
+
+#undef NULL_FUNCTION
+}
+
+bool NullBackend::Load()
+{
+  if (!gladLoadGLLoader(GetProcAddress))
+    return false;
+
+  // O cache pode ter sido preenchido por outro backend
+  GLState::Invalidate();
+
+  return true;
+}
+
+void *NullBackend::GetProcAddress(const char *name)
+{
+  for (const NullFunction &function : FUNCTIONS)
+    if (strcmp(function.name, name) == 0)
+      return function.proc;
+
+  return nullptr;
+}
+
+void NullBackend::ResetStats()
+{
+  stats.calls = 0;
+  stats.drawCalls = 0;
+  stats.drawnVertices = 0;
+  stats.uploadedBytes = 0;
+  stats.copiedBytes = 0;
+}
+
+const NullBackendStats &NullBackend::GetStats()
+{
+  return stats;
+}
+
+long NullBackend::GetBufferSize(unsigned int buffer)
+{
+  auto size = bufferSizes.find(buffer);
+
+  return size != bufferSizes.end() ? size->second : 0;
+}
@@ -0,0 +1,82 @@
+#include "engine/RecordingBackend.hpp"
+
+RecordingBackend::RecordingBackend()
+{
+  Clear();
+}
+
+void RecordingBackend::Record(RecordedCommandType type, unsigned int a, unsigned int b, unsigned int c)
+{
+  m_Commands.push_back({type, {a, b, c}});
+  m_Counts[type]++;
+}
+
+void RecordingBackend::UseProgram(unsigned int program)
+{
+  Record(RC_USE_PROGRAM, program);
+}
+
+void RecordingBackend::BindVertexArray(unsigned int vertexArray)
+{
+  Record(RC_BIND_VERTEX_ARRAY, vertexArray);
+}
+
+void RecordingBackend::BindIndexBuffer(unsigned int buffer)
+{
+  Record(RC_BIND_INDEX_BUFFER, buffer);
+}
+
+void RecordingBackend::BindTexture(unsigned int unit, unsigned int target, unsigned int texture)
+{
+  Record(RC_BIND_TEXTURE, unit, target, texture);
+}
+
+void RecordingBackend::SetEnabled(unsigned int capability, bool isEnabled)
+{
+  Record(RC_SET_ENABLED, capability, isEnabled);
+}
+
+void RecordingBackend::BlendFunc(unsigned int source, unsigned int destination)
+{
+  Record(RC_BLEND_FUNC, source, destination);
+}
+
+void RecordingBackend::PolygonMode(unsigned int mode)
+{
+  Record(RC_POLYGON_MODE, mode);
+}
+
+void RecordingBackend::SetUniform(int location, int value)
+{
+  Record(RC_SET_UNIFORM, location, value);
+}
+
+void RecordingBackend::SetUniform(int location, const glm::mat4 &value)
+{
+  Record(RC_SET_UNIFORM, location);
+}
+
+void RecordingBackend::MultiDrawArrays(const int *firsts, const int *counts, int drawCount)
+{
+  Record(RC_DRAW, drawCount);
+
+  for (int i = 0; i < drawCount; i++)
+    m_DrawnVertices += counts[i];
+}
+
+void RecordingBackend::DrawElements(int count, unsigned int offset)
+{
+  Record(RC_DRAW, 1, count, offset);
+
+  m_DrawnVertices += count;
+}
+
+void RecordingBackend::Clear()
+{
+  m_Commands.clear();
+
+  for (int &count : m_Counts)
+    count = 0;
+
+  m_DrawnVertices = 0;
+}
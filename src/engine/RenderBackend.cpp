@@ -0,0 +1,60 @@
+#include "core.h"
+
+#include "engine/RenderBackend.hpp"
+
+#include "engine/GLState.hpp"
+
+void GLRenderBackend::UseProgram(unsigned int program)
+{
+  GLState::UseProgram(program);
+}
+
+void GLRenderBackend::BindVertexArray(unsigned int vertexArray)
+{
+  GLState::BindVertexArray(vertexArray);
+}
+
+void GLRenderBackend::BindIndexBuffer(unsigned int buffer)
+{
+  GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer);
+}
+
+void GLRenderBackend::BindTexture(unsigned int unit, unsigned int target, unsigned int texture)
+{
+  GLState::BindTexture(unit, target, texture);
+}
+
+void GLRenderBackend::SetEnabled(unsigned int capability, bool isEnabled)
+{
+  GLState::SetEnabled(capability, isEnabled);
+}
+
+void GLRenderBackend::BlendFunc(unsigned int source, unsigned int destination)
+{
+  GLState::BlendFunc(source, destination);
+}
+
+void GLRenderBackend::PolygonMode(unsigned int mode)
+{
+  GLState::PolygonMode(mode);
+}
+
+void GLRenderBackend::SetUniform(int location, int value)
+{
+  glUniform1i(location, value);
+}
+
+void GLRenderBackend::SetUniform(int location, const glm::mat4 &value)
+{
+  glUniformMatrix4fv(location, 1, GL_FALSE, &value[0][0]);
+}
+
+void GLRenderBackend::MultiDrawArrays(const int *firsts, const int *counts, int drawCount)
+{
+  glMultiDrawArrays(GL_TRIANGLES, firsts, counts, drawCount);
+}
+
+void GLRenderBackend::DrawElements(int count, unsigned int offset)
+{
+  glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, reinterpret_cast<const void *>(static_cast<uintptr_t>(offset)));
+}
@@ -0,0 +1,226 @@
+#include <algorithm>
+
+#include "core.h"
+
+#include "engine/RenderQueue.hpp"
+
+#include "core/Profiler.hpp"
+
+namespace
+{
+  const unsigned int UNKNOWN = 0xFFFFFFFF;
+  const int MAX_TEXTURE_UNITS = 16;
+}
+
+RenderQueue::RenderQueue(float farDistance)
+    : m_Sequence(0),
+      m_FarDistance(farDistance),
+      m_IsWireframe(false),
+      m_Stats()
+{
+}
+
+uint32_t RenderQueue::QuantizeDepth(float distance) const
+{
+  float depth = glm::clamp(distance / m_FarDistance, 0.0f, 1.0f);
+
+  return static_cast<uint32_t>(depth * ((1 << DEPTH_BITS) - 1));
+}
+
+uint64_t RenderQueue::MakeKey(DrawPass pass, unsigned int program, unsigned int texture, unsigned int vertexArray, uint32_t depth)
+{
+  const uint64_t idMask = (1 << ID_BITS) - 1;
+  const uint64_t depthMask = (1 << DEPTH_BITS) - 1;
+
+  uint64_t state = ((program & idMask) << (2 * ID_BITS)) | ((texture & idMask) << ID_BITS) | (vertexArray & idMask);
+  uint64_t key = static_cast<uint64_t>(pass) << (DEPTH_BITS + 3 * ID_BITS);
+
+  if (pass == DP_OPAQUE)
+    return key | (state << DEPTH_BITS) | (depth & depthMask);
+
+  // Nos passes com mistura a ordem vem antes do estado
+  if (pass == DP_TRANSPARENT)
+    depth = ~depth;
+
+  return key | ((depth & depthMask) << (3 * ID_BITS)) | state;
+}
+
+void RenderQueue::Clear()
+{
+  m_Packets.clear();
+  m_Items.clear();
+
+  m_Sequence = 0;
+}
+
+void RenderQueue::Submit(DrawPass pass, float distance, const DrawPacket &packet)
+{
+  // A interface é desenhada na ordem em que foi enviada
+  uint32_t depth = pass == DP_INTERFACE ? m_Sequence++ : QuantizeDepth(distance);
+  unsigned int texture = packet.textureCount > 0 ? packet.textures[0].texture : 0;
+
+  m_Items.push_back({MakeKey(pass, packet.program, texture, packet.vertexArray, depth), static_cast<uint32_t>(m_Packets.size())});
+  m_Packets.push_back(packet);
+}
+
+void RenderQueue::Sort()
+{
+  size_t count = m_Items.size();
+
+  m_SortBuffer.resize(count);
+
+  for (int shift = 0; shift < 64; shift += 8)
+  {
+    size_t offsets[256] = {};
+
+    for (const SortItem &item : m_Items)
+      offsets[(item.key >> shift) & 0xFF]++;
+
+    // Todas as chaves têm o mesmo dígito, então este passo não muda a ordem
+    if (offsets[(m_Items[0].key >> shift) & 0xFF] == count)
+      continue;
+
+    size_t offset = 0;
+
+    for (size_t &digitOffset : offsets)
+    {
+      size_t digitCount = digitOffset;
+      digitOffset = offset;
+      offset += digitCount;
+    }
+
+    for (const SortItem &item : m_Items)
+      m_SortBuffer[offsets[(item.key >> shift) & 0xFF]++] = item;
+
+    m_Items.swap(m_SortBuffer);
+  }
+}
+
+void RenderQueue::SetPassState(RenderBackend &backend, DrawPass pass)
+{
+  bool isBlended = pass != DP_OPAQUE;
+
+  backend.SetEnabled(GL_DEPTH_TEST, pass != DP_INTERFACE);
+  backend.SetEnabled(GL_BLEND, isBlended);
+
+  if (isBlended)
+    backend.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+  backend.PolygonMode(m_IsWireframe && pass != DP_INTERFACE ? GL_LINE : GL_FILL);
+
+  int changes = isBlended ? 4 : 3;
+
+  m_Stats.stateChanges += changes;
+  m_Stats.passStateChanges[pass] += changes;
+}
+
+void RenderQueue::Execute(RenderBackend &backend)
+{
+  PROFILE_ZONE("RenderQueue::Execute");
+
+  m_Stats = RenderQueueStats();
+  m_Stats.packets = static_cast<int>(m_Packets.size());
+
+  if (m_Items.empty())
+    return;
+
+  Sort();
+
+  int pass = -1;
+
+  unsigned int program = UNKNOWN;
+  unsigned int vertexArray = UNKNOWN;
+  unsigned int indexBuffer = UNKNOWN;
+
+  PacketTexture textures[MAX_TEXTURE_UNITS];
+
+  for (PacketTexture &texture : textures)
+    texture = {UNKNOWN, UNKNOWN, UNKNOWN};
+
+  // Atualiza o valor e retorna se ele mudou, contando a chamada como enviada ou evitada
+  auto changes = [this, &pass](unsigned int &current, unsigned int value)
+  {
+    if (current == value)
+    {
+      m_Stats.elidedStateChanges++;
+      return false;
+    }
+
+    current = value;
+    m_Stats.stateChanges++;
+    m_Stats.passStateChanges[pass]++;
+
+    return true;
+  };
+
+  for (const SortItem &item : m_Items)
+  {
+    const DrawPacket &packet = m_Packets[item.packet];
+
+    int packetPass = static_cast<int>(item.key >> (DEPTH_BITS + 3 * ID_BITS));
+
+    if (packetPass != pass)
+    {
+      pass = packetPass;
+      SetPassState(backend, static_cast<DrawPass>(pass));
+    }
+
+    if (changes(program, packet.program))
+      backend.UseProgram(packet.program);
+
+    if (changes(vertexArray, packet.vertexArray))
+    {
+      backend.BindVertexArray(packet.vertexArray);
+
+      // O index buffer faz parte do estado do VAO
+      indexBuffer = UNKNOWN;
+    }
+
+    if (packet.command == DC_ELEMENTS && changes(indexBuffer, packet.indexBuffer))
+      backend.BindIndexBuffer(packet.indexBuffer);
+
+    for (int i = 0; i < packet.textureCount; i++)
+    {
+      const PacketTexture &texture = packet.textures[i];
+      PacketTexture &bound = textures[texture.unit];
+
+      if (bound.target == texture.target && bound.texture == texture.texture)
+      {
+        m_Stats.elidedStateChanges++;
+        continue;
+      }
+
+      bound = texture;
+      m_Stats.stateChanges++;
+      m_Stats.passStateChanges[pass]++;
+
+      backend.BindTexture(texture.unit, texture.target, texture.texture);
+    }
+
+    // Uniforms próprios do pacote são sempre enviados, já que o valor anterior pertence a outro desenho
+    for (int i = 0; i < packet.uniformCount; i++)
+    {
+      const PacketUniform &uniform = packet.uniforms[i];
+
+      if (uniform.isMatrix)
+        backend.SetUniform(uniform.location, uniform.matrix);
+      else
+        backend.SetUniform(uniform.location, uniform.integer);
+    }
+
+    if (packet.command == DC_MULTI_ARRAYS)
+    {
+      if (packet.drawList->GetSize() == 0)
+        continue;
+
+      backend.MultiDrawArrays(packet.drawList->firsts.data(), packet.drawList->counts.data(), packet.drawList->GetSize());
+    }
+    else
+      backend.DrawElements(packet.elementCount, packet.elementOffset);
+
+    m_Stats.drawCalls++;
+  }
+
+  // Deixa o estado padrão para o que for desenhado fora da fila
+  SetPassState(backend, DP_OPAQUE);
+}
@@ -7,6 +7,7 @@
 #include "core.h"
 
 #include "engine/Shader.hpp"
+#include "engine/GLState.hpp"
 #include "engine/Renderer.hpp"
 
 // Classe para load, compilação e uso de shaders
@@ -16,11 +17,13 @@ Shader::Shader(const std::string &filepath)
 {
   ShaderProgramSource source = ParseShader(filepath);
   m_RendererId = CreateShader(source.VertexSource, source.FragmentSource);
+
+  ResolveUniforms();
 }
 
 Shader::~Shader()
 {
-  glDeleteProgram(m_RendererId);
+  GLState::DeleteProgram(m_RendererId);
 }
 
 ShaderProgramSource Shader::ParseShader(const std::string &filePath)
@@ -107,14 +110,41 @@ unsigned int Shader::CreateShader(const std::string &vertexShader, const std::st
   return program;
 }
 
+void Shader::ResolveUniforms()
+{
+  int uniformCount = 0;
+  glGetProgramiv(m_RendererId, GL_ACTIVE_UNIFORMS, &uniformCount);
+
+  for (int i = 0; i < uniformCount; i++)
+  {
+    char name[256];
+    int length;
+    int size;
+    unsigned int type;
+
+    glGetActiveUniform(m_RendererId, i, sizeof(name), &length, &size, &type, name);
+
+    // Membros de blocos de uniforms não têm localização
+    int location = glGetUniformLocation(m_RendererId, name);
+
+    if (location != -1)
+      m_UniformLocationCache[name] = location;
+  }
+
+  unsigned int frameBlock = glGetUniformBlockIndex(m_RendererId, "Frame");
+
+  if (frameBlock != GL_INVALID_INDEX)
+    glUniformBlockBinding(m_RendererId, frameBlock, FRAME_BLOCK_BINDING);
+}
+
 void Shader::Bind() const
 {
-  glUseProgram(m_RendererId);
+  GLState::UseProgram(m_RendererId);
 }
 
 void Shader::Unbind() const
 {
-  glUseProgram(0);
+  GLState::UseProgram(0);
 }
 
 void Shader::SetUniform1i(const std::string &name, int value)
@@ -127,6 +157,11 @@ void Shader::SetUniform1f(const std::string &name, float value)
   glUniform1f(GetUniformLocation(name), value);
 }
 
+void Shader::SetUniform2f(const std::string &name, float v0, float v1)
+{
+  glUniform2f(GetUniformLocation(name), v0, v1);
+}
+
 void Shader::SetUniform4f(const std::string &name, float v0, float v1, float v2, float v3)
 {
   glUniform4f(GetUniformLocation(name), v0, v1, v2, v3);
@@ -137,6 +172,31 @@ void Shader::SetUniformMat4f(const std::string &name, const glm::mat4 matrix)
   glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, &matrix[0][0]);
 }
 
+void Shader::SetUniform(Uniform<int> uniform, int value)
+{
+  glUniform1i(uniform.location, value);
+}
+
+void Shader::SetUniform(Uniform<float> uniform, float value)
+{
+  glUniform1f(uniform.location, value);
+}
+
+void Shader::SetUniform(Uniform<glm::vec2> uniform, glm::vec2 value)
+{
+  glUniform2f(uniform.location, value.x, value.y);
+}
+
+void Shader::SetUniform(Uniform<glm::vec4> uniform, glm::vec4 value)
+{
+  glUniform4f(uniform.location, value.x, value.y, value.z, value.w);
+}
+
+void Shader::SetUniform(Uniform<glm::mat4> uniform, const glm::mat4 &value)
+{
+  glUniformMatrix4fv(uniform.location, 1, GL_FALSE, &value[0][0]);
+}
+
 int Shader::GetUniformLocation(const std::string &name)
 {
   if (m_UniformLocationCache.find(name) != m_UniformLocationCache.end())
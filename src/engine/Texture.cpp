@@ -3,6 +3,7 @@
 #include <stb_image/stb_image.h>
 
 #include "engine/Texture.hpp"
+#include "engine/GLState.hpp"
 
 // Classe para load e uso de texturas
 Texture::Texture(const std::string &path, bool pixelated)
@@ -14,7 +15,7 @@ Texture::Texture(const std::string &path, bool pixelated)
   m_LocalBuffer = stbi_load(path.c_str(), &m_Width, &m_Height, &m_BPP, 4);
 
   glGenTextures(1, &m_RendererId);
-  glBindTexture(GL_TEXTURE_2D, m_RendererId);
+  GLState::BindTexture(0, GL_TEXTURE_2D, m_RendererId);
 
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, pixelated ? GL_NEAREST : GL_LINEAR);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, pixelated ? GL_NEAREST : GL_LINEAR);
@@ -22,7 +23,6 @@ Texture::Texture(const std::string &path, bool pixelated)
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
   glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, m_LocalBuffer);
-  glBindTexture(GL_TEXTURE_2D, 0);
 
   if (m_LocalBuffer)
     stbi_image_free(m_LocalBuffer);
@@ -30,16 +30,15 @@ Texture::Texture(const std::string &path, bool pixelated)
 
 Texture::~Texture()
 {
-  glDeleteTextures(1, &m_RendererId);
+  GLState::DeleteTexture(m_RendererId);
 }
 
 void Texture::Bind(unsigned int slot) const
 {
-  glActiveTexture(GL_TEXTURE0 + slot);
-  glBindTexture(GL_TEXTURE_2D, m_RendererId);
+  GLState::BindTexture(slot, GL_TEXTURE_2D, m_RendererId);
 }
 
-void Texture::Unbind() const
+void Texture::Unbind(unsigned int slot) const
 {
-  glBindTexture(GL_TEXTURE_2D, 0);
+  GLState::BindTexture(slot, GL_TEXTURE_2D, 0);
 }
@@ -0,0 +1,45 @@
+#include "core.h"
+
+#include "engine/TextureBuffer.hpp"
+#include "engine/GLState.hpp"
+
+// Classe para gerenciamento de buffer texture
+TextureBuffer::TextureBuffer(unsigned int internalFormat)
+{
+  glGenBuffers(1, &m_BufferId);
+  GLState::BindBuffer(GL_TEXTURE_BUFFER, m_BufferId);
+  glBufferData(GL_TEXTURE_BUFFER, 0, nullptr, GL_DYNAMIC_DRAW);
+
+  // A textura continua ligada ao mesmo buffer quando ele é realocado por SetData
+  glGenTextures(1, &m_TextureId);
+  GLState::BindTexture(0, GL_TEXTURE_BUFFER, m_TextureId);
+  glTexBuffer(GL_TEXTURE_BUFFER, internalFormat, m_BufferId);
+}
+
+TextureBuffer::~TextureBuffer()
+{
+  GLState::DeleteTexture(m_TextureId);
+  GLState::DeleteBuffer(m_BufferId);
+}
+
+void TextureBuffer::SetData(const void *data, unsigned int size)
+{
+  GLState::BindBuffer(GL_TEXTURE_BUFFER, m_BufferId);
+  glBufferData(GL_TEXTURE_BUFFER, size, data, GL_DYNAMIC_DRAW);
+}
+
+void TextureBuffer::SetSubData(const void *data, unsigned int offset, unsigned int size)
+{
+  GLState::BindBuffer(GL_TEXTURE_BUFFER, m_BufferId);
+  glBufferSubData(GL_TEXTURE_BUFFER, offset, size, data);
+}
+
+void TextureBuffer::Bind(unsigned int slot) const
+{
+  GLState::BindTexture(slot, GL_TEXTURE_BUFFER, m_TextureId);
+}
+
+void TextureBuffer::Unbind(unsigned int slot) const
+{
+  GLState::BindTexture(slot, GL_TEXTURE_BUFFER, 0);
+}
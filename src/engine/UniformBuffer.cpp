@@ -0,0 +1,30 @@
+#include "core.h"
+
+#include "engine/UniformBuffer.hpp"
+#include "engine/GLState.hpp"
+
+// Classe para gerenciamento de uniform buffer
+UniformBuffer::UniformBuffer(unsigned int size)
+    : m_Size(size)
+{
+  glGenBuffers(1, &m_RendererId);
+  GLState::BindBuffer(GL_UNIFORM_BUFFER, m_RendererId);
+  glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+  GLState::BindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+UniformBuffer::~UniformBuffer()
+{
+  GLState::DeleteBuffer(m_RendererId);
+}
+
+void UniformBuffer::SetData(const void *data)
+{
+  GLState::BindBuffer(GL_UNIFORM_BUFFER, m_RendererId);
+  glBufferSubData(GL_UNIFORM_BUFFER, 0, m_Size, data);
+}
+
+void UniformBuffer::BindBase(unsigned int binding) const
+{
+  GLState::BindBufferBase(GL_UNIFORM_BUFFER, binding, m_RendererId);
+}
@@ -0,0 +1,153 @@
+#include <algorithm>
+
+#include "core.h"
+
+#include "engine/VertexArena.hpp"
+
+VertexArena::VertexArena(const VertexBufferLayout &layout, unsigned int vertexSize, int initialPages)
+    : m_Layout(layout),
+      m_VertexSize(vertexSize),
+      m_VertexArray(new VertexArray()),
+      m_VertexBuffer(new VertexBuffer(nullptr, initialPages * PAGE_VERTICES * vertexSize)),
+      m_Allocator(initialPages),
+      m_PageOrigins(new TextureBuffer(GL_RG32I)),
+      m_PageOriginData(initialPages, glm::ivec2(0)),
+      m_VertexCount(0),
+      m_FailedAllocations(0)
+{
+  m_VertexArray->AddBuffer(*m_VertexBuffer, m_Layout);
+
+  m_PageOrigins->SetData(m_PageOriginData.data(), m_PageOriginData.size() * sizeof(glm::ivec2));
+}
+
+VertexArena::~VertexArena()
+{
+  delete m_VertexArray;
+  delete m_VertexBuffer;
+  delete m_PageOrigins;
+}
+
+void VertexArena::Resize(int pages)
+{
+  VertexBuffer *vertexBuffer = new VertexBuffer(nullptr, pages * PAGE_VERTICES * m_VertexSize);
+
+  vertexBuffer->CopySubData(*m_VertexBuffer, 0, 0, m_Allocator.GetCapacity() * PAGE_VERTICES * m_VertexSize);
+
+  delete m_VertexBuffer;
+  m_VertexBuffer = vertexBuffer;
+
+  m_VertexArray->AddBuffer(*m_VertexBuffer, m_Layout);
+
+  m_Allocator.Grow(pages);
+
+  m_PageOriginData.resize(pages, glm::ivec2(0));
+  m_PageOrigins->SetData(m_PageOriginData.data(), m_PageOriginData.size() * sizeof(glm::ivec2));
+}
+
+int VertexArena::Allocate(const void *vertices, int vertexCount, glm::ivec2 origin)
+{
+  int pages = GetPageCount(vertexCount);
+
+  int handle = m_Allocator.Allocate(pages);
+
+  // Há espaço livre suficiente, mas dividido em blocos menores
+  if (handle == BufferAllocator::INVALID && m_Allocator.GetFree() >= pages)
+  {
+    Defragment();
+    handle = m_Allocator.Allocate(pages);
+  }
+
+  if (handle == BufferAllocator::INVALID && m_Allocator.GetCapacity() < MAX_PAGES)
+  {
+    int capacity = std::max(m_Allocator.GetCapacity() * 2, m_Allocator.GetCapacity() + pages);
+
+    Resize(std::min(capacity, MAX_PAGES));
+    handle = m_Allocator.Allocate(pages);
+  }
+
+  if (handle == BufferAllocator::INVALID)
+  {
+    m_FailedAllocations++;
+    return BufferAllocator::INVALID;
+  }
+
+  int offset = m_Allocator.GetOffset(handle);
+
+  m_VertexBuffer->SetSubData(vertices, offset * PAGE_VERTICES * m_VertexSize, vertexCount * m_VertexSize);
+
+  std::fill(m_PageOriginData.begin() + offset, m_PageOriginData.begin() + offset + pages, origin);
+  m_PageOrigins->SetSubData(&m_PageOriginData[offset], offset * sizeof(glm::ivec2), pages * sizeof(glm::ivec2));
+
+  if (handle >= static_cast<int>(m_VertexCounts.size()))
+    m_VertexCounts.resize(handle + 1, 0);
+
+  m_VertexCounts[handle] = vertexCount;
+  m_VertexCount += vertexCount;
+
+  return handle;
+}
+
+void VertexArena::Free(int handle)
+{
+  m_VertexCount -= m_VertexCounts[handle];
+  m_VertexCounts[handle] = 0;
+
+  m_Allocator.Free(handle);
+}
+
+// Copia só as alocações vivas para um novo buffer, pois glCopyBufferSubData não aceita origem e destino
+// sobrepostos no mesmo buffer: as que não se moveram na mesma posição e as deslocadas na posição nova
+void VertexArena::Defragment()
+{
+  std::vector<BufferAllocator::Move> moves = m_Allocator.Defragment();
+
+  if (moves.empty())
+    return;
+
+  unsigned int pageSize = PAGE_VERTICES * m_VertexSize;
+
+  VertexBuffer *vertexBuffer = new VertexBuffer(nullptr, m_Allocator.GetCapacity() * pageSize);
+
+  // As alocações ficam juntas na ordem das posições, então depois da primeira que se move todas as seguintes
+  // também se movem, e as que ficaram no lugar ocupam exatamente o intervalo antes da posição nova dela
+  int unmovedPages = moves.front().newOffset;
+
+  if (unmovedPages > 0)
+    vertexBuffer->CopySubData(*m_VertexBuffer, 0, 0, unmovedPages * pageSize);
+
+  for (const BufferAllocator::Move &move : moves)
+  {
+    vertexBuffer->CopySubData(*m_VertexBuffer, move.oldOffset * pageSize, move.newOffset * pageSize, move.size * pageSize);
+
+    // As alocações só se movem para trás, então a cópia em ordem crescente não sobrescreve origens ainda não copiadas
+    std::copy(m_PageOriginData.begin() + move.oldOffset, m_PageOriginData.begin() + move.oldOffset + move.size, m_PageOriginData.begin() + move.newOffset);
+  }
+
+  delete m_VertexBuffer;
+  m_VertexBuffer = vertexBuffer;
+
+  m_VertexArray->AddBuffer(*m_VertexBuffer, m_Layout);
+
+  m_PageOrigins->SetSubData(m_PageOriginData.data(), 0, m_PageOriginData.size() * sizeof(glm::ivec2));
+}
+
+bool VertexArena::IsFragmented() const
+{
+  return m_Allocator.GetFragmentation() > 0.5f && m_Allocator.GetFree() - m_Allocator.GetLargestFreeBlock() > m_Allocator.GetCapacity() / 4;
+}
+
+VertexArenaStats VertexArena::GetStats() const
+{
+  VertexArenaStats stats;
+
+  stats.capacity = m_Allocator.GetCapacity() * PAGE_VERTICES;
+  stats.allocated = m_Allocator.GetUsed() * PAGE_VERTICES;
+  stats.vertices = m_VertexCount;
+  stats.allocations = m_Allocator.GetAllocationCount();
+  stats.freeBlocks = m_Allocator.GetFreeBlockCount();
+  stats.largestFreeBlock = m_Allocator.GetLargestFreeBlock() * PAGE_VERTICES;
+  stats.fragmentation = m_Allocator.GetFragmentation();
+  stats.failedAllocations = m_FailedAllocations;
+
+  return stats;
+}
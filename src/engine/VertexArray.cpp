@@ -1,5 +1,6 @@
 #include "engine/VertexArray.hpp"
 
+#include "engine/GLState.hpp"
 #include "engine/VertexBufferLayout.hpp"
 #include "engine/Renderer.hpp"
 
@@ -11,7 +12,7 @@ VertexArray::VertexArray()
 
 VertexArray::~VertexArray()
 {
-  glDeleteVertexArrays(1, &m_RendererId);
+  GLState::DeleteVertexArray(m_RendererId);
 }
 
 void VertexArray::AddBuffer(const VertexBuffer &vb, const VertexBufferLayout &layout)
@@ -26,8 +27,14 @@ void VertexArray::AddBuffer(const VertexBuffer &vb, const VertexBufferLayout &la
   {
     const auto &element = elements[i];
 
+    const void *pointer = reinterpret_cast<const void *>(static_cast<uintptr_t>(offset));
+
     glEnableVertexAttribArray(i);
-    glVertexAttribPointer(i, element.count, element.type, element.normalized, layout.GetStride(), (const void *)offset);
+
+    if (element.isInteger)
+      glVertexAttribIPointer(i, element.count, element.type, layout.GetStride(), pointer);
+    else
+      glVertexAttribPointer(i, element.count, element.type, element.normalized, layout.GetStride(), pointer);
 
     offset += element.count * VertexBufferElement::GetSizeOfType(element.type);
   }
@@ -35,10 +42,10 @@ void VertexArray::AddBuffer(const VertexBuffer &vb, const VertexBufferLayout &la
 
 void VertexArray::Bind() const
 {
-  glBindVertexArray(m_RendererId);
+  GLState::BindVertexArray(m_RendererId);
 }
 
 void VertexArray::Unbind() const
 {
-  glBindVertexArray(0);
+  GLState::BindVertexArray(0);
 }
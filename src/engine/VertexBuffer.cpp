@@ -1,28 +1,49 @@
 #include "core.h"
 
 #include "engine/VertexBuffer.hpp"
+#include "engine/GLState.hpp"
 
 #include "engine/Renderer.hpp"
 
 // Classe para gerenciamento de vertex buffer
-VertexBuffer::VertexBuffer(const void *data, unsigned int size)
+VertexBuffer::VertexBuffer(const void *data, unsigned int size, bool isDynamic)
+    : m_Usage(isDynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW)
 {
   glGenBuffers(1, &m_RendererId);
-  glBindBuffer(GL_ARRAY_BUFFER, m_RendererId);
-  glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
+  GLState::BindBuffer(GL_ARRAY_BUFFER, m_RendererId);
+  glBufferData(GL_ARRAY_BUFFER, size, data, m_Usage);
 }
 
 VertexBuffer::~VertexBuffer()
 {
-  glDeleteBuffers(1, &m_RendererId);
+  GLState::DeleteBuffer(m_RendererId);
+}
+
+void VertexBuffer::SetData(const void *data, unsigned int size)
+{
+  GLState::BindBuffer(GL_ARRAY_BUFFER, m_RendererId);
+  glBufferData(GL_ARRAY_BUFFER, size, data, m_Usage);
+}
+
+void VertexBuffer::SetSubData(const void *data, unsigned int offset, unsigned int size)
+{
+  GLState::BindBuffer(GL_ARRAY_BUFFER, m_RendererId);
+  glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+}
+
+void VertexBuffer::CopySubData(const VertexBuffer &source, unsigned int readOffset, unsigned int writeOffset, unsigned int size)
+{
+  GLState::BindBuffer(GL_COPY_READ_BUFFER, source.m_RendererId);
+  GLState::BindBuffer(GL_COPY_WRITE_BUFFER, m_RendererId);
+  glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, readOffset, writeOffset, size);
 }
 
 void VertexBuffer::Bind() const
 {
-  glBindBuffer(GL_ARRAY_BUFFER, m_RendererId);
+  GLState::BindBuffer(GL_ARRAY_BUFFER, m_RendererId);
 }
 
 void VertexBuffer::Unbind() const
 {
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
 }
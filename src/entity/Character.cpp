@@ -2,9 +2,12 @@
 
 #include <cstdio>
 
+#include "core/Profiler.hpp"
+
 // Classe para gerenciamento do personagem
 Character::Character(Shader *shader, glm::vec4 position)
     : m_Shader(shader),
+      m_TransformUniform(shader->GetUniform<glm::mat4>("uTransform")),
       m_Position(position)
 {
   // Inicializa a hotbar com os 9 primeiros blocos
@@ -78,10 +81,10 @@ void Character::SetHotbarItem(int position, int id)
 {
   m_Hotbar[position] = id;
 
-  BlockInformation blockInfo = BlockDatabase::GetBlockInformationIndex(id);
+  const BlockInformation &blockInfo = BlockDatabase::GetBlockInformationIndex(id);
 
   // Textura do ícone é a face, porém para as folhas é o lado
-  int offset = blockInfo.blockId.find("_leaves") != std::string::npos ? 24 : 0;
+  int offset = strstr(blockInfo.blockId, "_leaves") != NULL ? 24 : 0;
 
   std::array<glm::vec2, 4> faceCoords = {
       blockInfo.textureCoordinates[offset + 0],
@@ -95,6 +98,8 @@ void Character::SetHotbarItem(int position, int id)
 // Função de atualização do personagem que é chamada a cada frame
 void Character::Update(Camera *camera, World *world)
 {
+  PROFILE_ZONE("Character::Update");
+
   // Atualiza ângulos da câmera com base no delta da posição do mouse
   glm::vec2 deltaPos = Input::GetDeltaMousePosition();
 
@@ -329,21 +334,23 @@ void Character::Update(Camera *camera, World *world)
 }
 
 // Desenha o model do personagem na posição da câmera
-void Character::Draw(Camera *camera, glm::mat4 view, glm::mat4 projection)
+void Character::Draw(RenderQueue &queue, Camera *camera)
 {
-  m_Shader->Bind();
+  glm::mat4 model = Matrices::MatrixTranslate(camera->GetPosition().x, camera->GetPosition().y - CHARACTER_HEIGHT, camera->GetPosition().z);
 
-  m_Shader->SetUniformMat4f("uView", view);
-  m_Shader->SetUniformMat4f("uProjection", projection);
+  DrawPacket packet;
 
-  glm::mat4 model = Matrices::MatrixTranslate(camera->GetPosition().x, camera->GetPosition().y - CHARACTER_HEIGHT, camera->GetPosition().z);
+  packet.program = m_Shader->GetRendererId();
+  packet.vertexArray = m_VAO->GetRendererId();
+  packet.indexBuffer = m_IB->GetRendererId();
 
-  m_Shader->SetUniformMat4f("uTransform", model);
+  packet.AddUniform(m_TransformUniform, model);
 
-  m_VAO->Bind();
-  m_IB->Bind();
+  packet.command = DC_ELEMENTS;
+  packet.elementCount = m_IB->GetCount();
 
-  glDrawElements(GL_TRIANGLES, m_IB->GetCount(), GL_UNSIGNED_INT, nullptr);
+  // O personagem está na posição da câmera
+  queue.Submit(DP_OPAQUE, 0.0f, packet);
 }
 
 // Gerencia o callback de click do mouse para o personagem
@@ -1,5 +1,7 @@
 #include "entity/UserInterface.hpp"
 
+#include "core/Profiler.hpp"
+
 const float UserInterface::crosshairWidth = 20.0f;
 const float UserInterface::crosshairHeight = 20.0f;
 
@@ -20,8 +22,86 @@ const float UserInterface::hotbarSelectorHeight = 68.0f;
 const float UserInterface::hotbarIconWidth = 32.0f;
 const float UserInterface::hotbarIconHeight = 32.0f;
 
-std::array<float, 5 * 4 *UI_HOTBAR_SIZE> UserInterface::hotbarVertices = {};
-std::array<unsigned int, 6 *UI_HOTBAR_SIZE> UserInterface::hotbarIndices = {};
+std::array<float, UserInterface::vertexSize * 4 * UIQ_COUNT> UserInterface::vertices = {};
+
+std::array<std::array<glm::vec2, 4>, UI_HOTBAR_SIZE> UserInterface::hotbarIconCoords = {};
+std::array<bool, UI_HOTBAR_SIZE> UserInterface::hotbarIconIsSet = {};
+
+Texture *UserInterface::crosshairTexture = nullptr;
+Texture *UserInterface::hotbarTexture = nullptr;
+Texture *UserInterface::hotbarSelectorTexture = nullptr;
+
+VertexArray *UserInterface::vertexArray = nullptr;
+VertexBuffer *UserInterface::vertexBuffer = nullptr;
+IndexBuffer *UserInterface::indexBuffer = nullptr;
+
+bool UserInterface::isDirty = true;
+int UserInterface::builtWidth = 0;
+int UserInterface::builtHeight = 0;
+int UserInterface::builtHotbarPosition = -1;
+
+int UserInterface::geometryBuilds = 0;
+
+// Carrega as texturas da interface uma única vez e cria os buffers persistentes
+void UserInterface::Init(Shader *shader)
+{
+  crosshairTexture = new Texture("extras/textures/crosshair.png", true);
+  hotbarTexture = new Texture("extras/textures/hotbar.png", true);
+  hotbarSelectorTexture = new Texture("extras/textures/hotbar_selector.png", true);
+
+  vertexArray = new VertexArray();
+  vertexBuffer = new VertexBuffer(vertices.data(), vertices.size() * sizeof(float), true);
+
+  VertexBufferLayout layout;
+  layout.Push(LayoutType::LT_FLOAT, 3);
+  layout.Push(LayoutType::LT_FLOAT, 2);
+  layout.Push(LayoutType::LT_FLOAT, 1);
+  vertexArray->AddBuffer(*vertexBuffer, layout);
+
+  // Os índices só dependem da quantidade de retângulos, então nunca mudam
+  std::array<unsigned int, 6 * UIQ_COUNT> indices;
+
+  for (int quad = 0; quad < UIQ_COUNT; quad++)
+  {
+    indices[quad * 6 + 0] = 0 + quad * 4;
+    indices[quad * 6 + 1] = 1 + quad * 4;
+    indices[quad * 6 + 2] = 2 + quad * 4;
+    indices[quad * 6 + 3] = 2 + quad * 4;
+    indices[quad * 6 + 4] = 3 + quad * 4;
+    indices[quad * 6 + 5] = 0 + quad * 4;
+  }
+
+  indexBuffer = new IndexBuffer(indices.data(), indices.size());
+
+  // Cada textura fica na unidade de mesmo número do seu UITexture
+  shader->Bind();
+
+  shader->SetUniform1i("uAtlas", UIT_ATLAS);
+  shader->SetUniform1i("uCrosshair", UIT_CROSSHAIR);
+  shader->SetUniform1i("uHotbar", UIT_HOTBAR);
+  shader->SetUniform1i("uHotbarSelector", UIT_HOTBAR_SELECTOR);
+
+  isDirty = true;
+}
+
+void UserInterface::Terminate()
+{
+  delete crosshairTexture;
+  delete hotbarTexture;
+  delete hotbarSelectorTexture;
+
+  delete vertexArray;
+  delete vertexBuffer;
+  delete indexBuffer;
+
+  crosshairTexture = nullptr;
+  hotbarTexture = nullptr;
+  hotbarSelectorTexture = nullptr;
+
+  vertexArray = nullptr;
+  vertexBuffer = nullptr;
+  indexBuffer = nullptr;
+}
 
 // Atualiza a textura do ícone na posição da hotbar
 void UserInterface::UpdateHotbarPosition(int position, std::array<glm::vec2, 4> textureCoords)
@@ -29,117 +109,117 @@ void UserInterface::UpdateHotbarPosition(int position, std::array<glm::vec2, 4>
   if (position >= UI_HOTBAR_SIZE)
     return;
 
-  int width = Window::GetWidth();
-  int height = Window::GetHeight();
-
-  float xUnit = (float)hotbarIconWidth / width;
-  float yUnit = (float)hotbarIconHeight / height;
+  hotbarIconCoords[position] = textureCoords;
+  hotbarIconIsSet[position] = true;
 
-  float slotCenterX = (-(int)floor(UI_HOTBAR_SIZE / 2) * hotbarSlotSize * 2 + position * hotbarSlotSize * 2) / width;
-
-  int hotbarVertexPosition = position * 20;
-  float yCenter = hotbarCenterY + (16 / width);
+  isDirty = true;
+}
 
+void UserInterface::SetQuad(int quad, const std::array<glm::vec2, 4> &positions, const std::array<glm::vec2, 4> &textureCoords, UITexture texture)
+{
   for (int i = 0; i < 4; i++)
   {
-    float xUnitSigned = i == 0 || i == 3 ? xUnit : -xUnit;
-    float yUnitSigned = i == 0 || i == 1 ? yUnit : -yUnit;
-
-    hotbarVertices[hotbarVertexPosition + i * 5 + 0] = slotCenterX + xUnitSigned;
-    hotbarVertices[hotbarVertexPosition + i * 5 + 1] = yCenter + yUnitSigned;
-    hotbarVertices[hotbarVertexPosition + i * 5 + 2] = 0.0f;
-    hotbarVertices[hotbarVertexPosition + i * 5 + 3] = textureCoords[i].x;
-    hotbarVertices[hotbarVertexPosition + i * 5 + 4] = textureCoords[i].y;
+    int vertex = (quad * 4 + i) * vertexSize;
+
+    vertices[vertex + 0] = positions[i].x;
+    vertices[vertex + 1] = positions[i].y;
+    vertices[vertex + 2] = 0.0f;
+    vertices[vertex + 3] = textureCoords[i].x;
+    vertices[vertex + 4] = textureCoords[i].y;
+    vertices[vertex + 5] = (float)texture;
   }
+}
 
-  hotbarIndices[position * 6 + 0] = 0 + position * 4;
-  hotbarIndices[position * 6 + 1] = 1 + position * 4;
-  hotbarIndices[position * 6 + 2] = 2 + position * 4;
-  hotbarIndices[position * 6 + 3] = 2 + position * 4;
-  hotbarIndices[position * 6 + 4] = 3 + position * 4;
-  hotbarIndices[position * 6 + 5] = 0 + position * 4;
+// Retângulo de um elemento de UI com uma textura inteira
+void UserInterface::SetElementQuad(int quad, UITexture texture, float elementWidth, float elementHeight, float centerX, float centerY)
+{
+  float xUnit = elementWidth / builtWidth;
+  float yUnit = elementHeight / builtHeight;
+
+  SetQuad(quad,
+          {glm::vec2(centerX - xUnit, centerY - yUnit),
+           glm::vec2(centerX + xUnit, centerY - yUnit),
+           glm::vec2(centerX + xUnit, centerY + yUnit),
+           glm::vec2(centerX - xUnit, centerY + yUnit)},
+          {glm::vec2(0.0f, 0.0f),
+           glm::vec2(1.0f, 0.0f),
+           glm::vec2(1.0f, 1.0f),
+           glm::vec2(0.0f, 1.0f)},
+          texture);
 }
 
-// Desenha um elemento de UI na tela
-void UserInterface::DrawUIElement(Shader *shader, std::string texturePath, int elementWidth, int elementHeight, float centerX, float centerY)
+// Reescreve os vértices de toda a interface no buffer persistente
+void UserInterface::BuildGeometry(int hotbarPosition)
 {
-  int width = Window::GetWidth();
-  int height = Window::GetHeight();
+  PROFILE_ZONE("UserInterface::BuildGeometry");
 
-  float xUnit = (float)elementWidth / width;
-  float yUnit = (float)elementHeight / height;
+  builtWidth = Window::GetWidth();
+  builtHeight = Window::GetHeight();
+  builtHotbarPosition = hotbarPosition;
 
-  std::array<float, 20> vertices = {
-      centerX - xUnit, centerY - yUnit, 0.0f, 0.0f, 0.0f,
-      centerX + xUnit, centerY - yUnit, 0.0f, 1.0f, 0.0f,
-      centerX + xUnit, centerY + yUnit, 0.0f, 1.0f, 1.0f,
-      centerX - xUnit, centerY + yUnit, 0.0f, 0.0f, 1.0f};
+  float selectorCenterX = (-(int)floor(UI_HOTBAR_SIZE / 2) * hotbarSlotSize * 2 + hotbarPosition * hotbarSlotSize * 2) / builtWidth;
 
-  std::array<unsigned int, 6> indices = {
-      0, 1, 2,
-      2, 3, 0};
+  SetElementQuad(UIQ_CROSSHAIR, UIT_CROSSHAIR, crosshairWidth, crosshairHeight, crosshairCenterX, crosshairCenterY);
+  SetElementQuad(UIQ_HOTBAR, UIT_HOTBAR, hotbarWidth, hotbarHeight, hotbarCenterX, hotbarCenterY);
+  SetElementQuad(UIQ_HOTBAR_SELECTOR, UIT_HOTBAR_SELECTOR, hotbarSelectorWidth, hotbarSelectorHeight, selectorCenterX, hotbarCenterY);
 
-  VertexArray va;
-  VertexBuffer vb(vertices.data(), vertices.size() * sizeof(float));
-  VertexBufferLayout layout;
-  layout.Push(LayoutType::LT_FLOAT, 3);
-  layout.Push(LayoutType::LT_FLOAT, 2);
-  va.AddBuffer(vb, layout);
+  float xUnit = (float)hotbarIconWidth / builtWidth;
+  float yUnit = (float)hotbarIconHeight / builtHeight;
 
-  IndexBuffer ib(indices.data(), indices.size());
+  float yCenter = hotbarCenterY + (16 / builtWidth);
 
-  Texture texture(texturePath, true);
-  texture.Bind(1);
-  shader->SetUniform1i("uTexture", 1);
+  for (int position = 0; position < UI_HOTBAR_SIZE; position++)
+  {
+    // Posições sem item ficam com um retângulo degenerado, que não gera fragmentos
+    if (!hotbarIconIsSet[position])
+    {
+      SetQuad(UIQ_HOTBAR_ICONS + position, {}, {}, UIT_ATLAS);
+      continue;
+    }
 
-  Renderer renderer;
+    float slotCenterX = (-(int)floor(UI_HOTBAR_SIZE / 2) * hotbarSlotSize * 2 + position * hotbarSlotSize * 2) / builtWidth;
 
-  renderer.Draw(va, ib, shader);
-}
+    std::array<glm::vec2, 4> positions;
 
-// Desenha os ícones da hotbar
-void UserInterface::DrawHotbarIcons(Shader *shader)
-{
-  shader->SetUniform1i("uTexture", 0);
+    for (int i = 0; i < 4; i++)
+    {
+      float xUnitSigned = i == 0 || i == 3 ? xUnit : -xUnit;
+      float yUnitSigned = i == 0 || i == 1 ? yUnit : -yUnit;
 
-  VertexArray va;
-  VertexBuffer vb(hotbarVertices.data(), 5 * 4 * UI_HOTBAR_SIZE * sizeof(float));
-  VertexBufferLayout layout;
-  layout.Push(LayoutType::LT_FLOAT, 3);
-  layout.Push(LayoutType::LT_FLOAT, 2);
-  va.AddBuffer(vb, layout);
+      positions[i] = glm::vec2(slotCenterX + xUnitSigned, yCenter + yUnitSigned);
+    }
 
-  IndexBuffer ib(hotbarIndices.data(), 6 * UI_HOTBAR_SIZE);
+    SetQuad(UIQ_HOTBAR_ICONS + position, positions, hotbarIconCoords[position], UIT_ATLAS);
+  }
 
-  Renderer renderer;
+  vertexBuffer->SetSubData(vertices.data(), 0, vertices.size() * sizeof(float));
 
-  renderer.Draw(va, ib, shader);
+  isDirty = false;
+  geometryBuilds++;
 }
 
-// Desenha os elementos de UI da aplicação
-void UserInterface::DrawUI(Shader *shader, Texture *atlas, int hotbarPosition)
+// Envia os elementos de UI da aplicação para a fila
+void UserInterface::DrawUI(RenderQueue &queue, Shader *shader, Texture *atlas, int hotbarPosition)
 {
-  GLint polygonMode;
-  glGetIntegerv(GL_POLYGON_MODE, &polygonMode);
-  glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+  PROFILE_ZONE("UserInterface::DrawUI");
 
-  glDisable(GL_DEPTH_TEST);
-  glEnable(GL_BLEND);
-  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  if (isDirty || hotbarPosition != builtHotbarPosition || Window::GetWidth() != builtWidth || Window::GetHeight() != builtHeight)
+    BuildGeometry(hotbarPosition);
 
-  float selectorCenterX = (-(int)floor(UI_HOTBAR_SIZE / 2) * hotbarSlotSize * 2 + hotbarPosition * hotbarSlotSize * 2) / Window::GetWidth();
+  DrawPacket packet;
 
-  shader->Bind();
-
-  DrawUIElement(shader, "extras/textures/crosshair.png", crosshairWidth, crosshairHeight, crosshairCenterX, crosshairCenterY);
-  DrawUIElement(shader, "extras/textures/hotbar.png", hotbarWidth, hotbarHeight, hotbarCenterX, hotbarCenterY);
-  DrawUIElement(shader, "extras/textures/hotbar_selector.png", hotbarSelectorWidth, hotbarSelectorHeight, selectorCenterX, hotbarCenterY);
+  packet.program = shader->GetRendererId();
+  packet.vertexArray = vertexArray->GetRendererId();
+  packet.indexBuffer = indexBuffer->GetRendererId();
 
-  atlas->Bind(0);
+  packet.AddTexture(UIT_ATLAS, GL_TEXTURE_2D, atlas->GetRendererId());
+  packet.AddTexture(UIT_CROSSHAIR, GL_TEXTURE_2D, crosshairTexture->GetRendererId());
+  packet.AddTexture(UIT_HOTBAR, GL_TEXTURE_2D, hotbarTexture->GetRendererId());
+  packet.AddTexture(UIT_HOTBAR_SELECTOR, GL_TEXTURE_2D, hotbarSelectorTexture->GetRendererId());
 
-  DrawHotbarIcons(shader);
+  // A ordem dos retângulos no buffer é a ordem de desenho, então a mistura continua correta em uma única chamada
+  packet.command = DC_ELEMENTS;
+  packet.elementCount = indexBuffer->GetCount();
 
-  glDisable(GL_BLEND);
-  glEnable(GL_DEPTH_TEST);
-  glPolygonMode(GL_FRONT_AND_BACK, polygonMode);
-}
\ No newline at end of file
+  queue.Submit(DP_INTERFACE, 0.0f, packet);
+}
@@ -4,6 +4,8 @@
 
 #include "entity/Input.hpp"
 
+#include "core/Profiler.hpp"
+
 float Window::screenRatio = 0.0f;
 float Window::deltaTime = 0.0f;
 float Window::lastFrame = 0.0f;
@@ -88,9 +90,19 @@ bool Window::Init(bool fullscreen)
   return true;
 }
 
+void Window::InitHeadless(int width, int height)
+{
+  Window::width = width;
+  Window::height = height;
+
+  screenRatio = (float)width / height;
+}
+
 // Faz poll dos eventos e atualiza o delta time
 void Window::Tick()
 {
+  PROFILE_ZONE("Window::Tick");
+
   glfwPollEvents();
 
   deltaTime = glfwGetTime() - lastFrame;
@@ -116,6 +128,9 @@ void Window::FramebufferSizeCallback(GLFWwindow *window, int width, int height)
 {
   glViewport(0, 0, width, height);
   screenRatio = (float)width / height;
+
+  Window::width = width;
+  Window::height = height;
 }
 
 float Window::GetScreenRatio()
@@ -1,9 +1,11 @@
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 
 #include <chrono>
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <limits>
@@ -26,7 +28,10 @@
 
 #include "core/utils.hpp"
 #include "core/Matrices.hpp"
+#include "core/Profiler.hpp"
 
+#include "engine/GLState.hpp"
+#include "engine/NullBackend.hpp"
 #include "engine/IndexBuffer.hpp"
 #include "engine/VertexArray.hpp"
 #include "engine/VertexBuffer.hpp"
@@ -34,6 +39,8 @@
 #include "engine/Shader.hpp"
 #include "engine/Texture.hpp"
 #include "engine/Renderer.hpp"
+#include "engine/RenderQueue.hpp"
+#include "engine/UniformBuffer.hpp"
 
 #include "entity/Camera.hpp"
 #include "entity/Input.hpp"
@@ -41,13 +48,229 @@
 #include "entity/UserInterface.hpp"
 
 #include "world/BlockDatabase.hpp"
+#include "world/TerrainGeneration.hpp"
 #include "world/World.hpp"
 #include "world/Object.hpp"
 
 #include "entity/Character.hpp"
 
-int main()
+// Ocupação e fragmentação da arena de vértices dos chunks
+static void PrintArenaStats(const VertexArenaStats &stats)
 {
+  printf("Vertex arena: %d of %d vertices allocated (%d used), %d allocations, %d free blocks, largest %d, %.1f%% fragmented, %d failed allocations \n", stats.allocated, stats.capacity, stats.vertices, stats.allocations, stats.freeBlocks, stats.largestFreeBlock, stats.fragmentation * 100.0f, stats.failedAllocations);
+}
+
+// Percentis das zonas do profiler, na janela recente de cada uma
+static void PrintZoneStats()
+{
+  for (const ZoneStats &zone : Profiler::GetZoneStats())
+    printf("Zone %s: %d calls, p50 %.3f ms, p95 %.3f ms, p99 %.3f ms \n", zone.name, zone.frameCalls, zone.p50, zone.p95, zone.p99);
+
+  if (Profiler::GetDroppedEvents() > 0)
+    printf("Profiler: %d events dropped \n", (int)Profiler::GetDroppedEvents());
+}
+
+// Gera o mundo e desenha frames sem janela nem GPU, pelo backend nulo, para medir o engine em máquinas de CI
+// A câmera anda e gira a cada frame para exercitar o carregamento de chunks, o meshing e o culling
+// Com um caminho de trace, todos os frames são capturados
+static int RunHeadless(int frames, const char *tracePath)
+{
+  if (!NullBackend::Load())
+  {
+    fprintf(stderr, "ERROR: Null backend initialization failed.\n");
+    return EXIT_FAILURE;
+  }
+
+  Window::InitHeadless(1280, 720);
+
+  BlockDatabase::Initialize();
+
+  Shader worldShader("extras/shaders/World.shader");
+  Shader interfaceShader("extras/shaders/Interface.shader");
+
+  UserInterface::Init(&interfaceShader);
+
+  UniformBuffer frameUniforms(sizeof(FrameConstants));
+  frameUniforms.BindBase(Shader::FRAME_BLOCK_BINDING);
+
+  Camera camera(-0.1f, -1024.0f, 60.0f);
+
+  GLState::SetEnabled(GL_DEPTH_TEST, true);
+  GLState::SetEnabled(GL_CULL_FACE, true);
+
+  if (tracePath)
+    Profiler::StartCapture(frames + 1, tracePath);
+
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+  {
+    World world(&worldShader, camera.GetPosition());
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    printf("Elapsed time: %f \n", (float)std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count());
+    printf("Mesh vertices: %d \n", (int)world.GetVertexCount());
+
+    PrintArenaStats(world.GetArenaStats());
+
+    RenderQueue renderQueue(-camera.GetFarplane());
+    GLRenderBackend glBackend;
+
+    NullBackend::ResetStats();
+
+    long visibleSections = 0;
+
+    begin = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < frames; frame++)
+    {
+      // Eventos do frame anterior, e da geração do mundo no primeiro frame
+      Profiler::Collect();
+
+      PROFILE_ZONE("Frame");
+
+      glm::vec4 position = glm::vec4(frame * 0.5f, 64.0f, -3.0f, 1.0f);
+
+      camera.UpdatePosition(position);
+      camera.UpdateCameraAngles(frame * 0.05f, -0.4f);
+
+      world.Update(camera.GetPosition());
+
+      glm::mat4 view = camera.ComputeViewMatrix();
+      glm::mat4 projection = camera.ComputeProjectionMatrix();
+
+      FrameConstants frameConstants = {view, projection, position};
+      frameUniforms.SetData(&frameConstants);
+
+      renderQueue.Clear();
+
+      world.Draw(renderQueue, &camera, view, projection);
+
+      UserInterface::DrawUI(renderQueue, &interfaceShader, world.GetTextureAtlas(), frame % UI_HOTBAR_SIZE);
+
+      renderQueue.Execute(glBackend);
+
+      visibleSections += world.GetCullingStats().visibleSections;
+    }
+
+    Profiler::Collect();
+
+    end = std::chrono::steady_clock::now();
+
+    float milliseconds = std::chrono::duration<float, std::milli>(end - begin).count();
+    int frameCount = frames > 0 ? frames : 1;
+
+    const NullBackendStats &stats = NullBackend::GetStats();
+
+    printf("Headless: %d frames in %.1f ms (%.3f ms per frame), %.1f visible sections per frame \n", frames, milliseconds, milliseconds / frameCount, (float)visibleSections / frameCount);
+    printf("Null backend: %.1f GL calls, %.1f draws, %.0f vertices per frame; %.2f MiB uploaded, %.2f MiB copied \n", (float)stats.calls / frameCount, (float)stats.drawCalls / frameCount, (float)stats.drawnVertices / frameCount, stats.uploadedBytes / (1024.0f * 1024.0f), stats.copiedBytes / (1024.0f * 1024.0f));
+    printf("Null backend resources: %d buffers (%.2f MiB), %d textures (%.2f MiB), %d vertex arrays, %d programs \n", stats.buffers, stats.bufferBytes / (1024.0f * 1024.0f), stats.textures, stats.textureBytes / (1024.0f * 1024.0f), stats.vertexArrays, stats.programs);
+
+    PrintArenaStats(world.GetArenaStats());
+    PrintZoneStats();
+  }
+
+  UserInterface::Terminate();
+
+  return 0;
+}
+
+// Compara o preenchimento antigo, um GetBlockAtHeight por voxel, com o FillColumn por faixas
+// em uma grade fixa de chunks; o terreno só depende da semente fixa, então as medidas são repetíveis
+// Os heightmaps são calculados antes, para medir só o preenchimento dos blocos
+static int RunFillBenchmark(int chunksPerAxis)
+{
+  const int columns = WorldConstants::CHUNK_SIZE * WorldConstants::CHUNK_SIZE;
+  const int chunkBlocks = columns * WorldConstants::CHUNK_HEIGHT;
+  const int repetitions = 5;
+
+  int chunkCount = chunksPerAxis * chunksPerAxis;
+
+  std::vector<int> heightMaps(chunkCount * columns);
+
+  for (int chunk = 0; chunk < chunkCount; chunk++)
+    TerrainGeneration::GetHeightMap(chunk % chunksPerAxis, chunk / chunksPerAxis, &heightMaps[chunk * columns]);
+
+  std::vector<uint8_t> voxelBlocks(chunkBlocks);
+  std::vector<uint8_t> columnBlocks(chunkBlocks);
+
+  float voxelMilliseconds = std::numeric_limits<float>::max();
+  float columnMilliseconds = std::numeric_limits<float>::max();
+  long mismatches = 0;
+
+  // Menor tempo entre as repetições, para descontar ruído da máquina
+  for (int repetition = 0; repetition < repetitions; repetition++)
+  {
+    float voxelTime = 0.0f;
+    float columnTime = 0.0f;
+
+    mismatches = 0;
+
+    for (int chunk = 0; chunk < chunkCount; chunk++)
+    {
+      int baseX = (chunk % chunksPerAxis) * WorldConstants::CHUNK_SIZE;
+      int baseZ = (chunk / chunksPerAxis) * WorldConstants::CHUNK_SIZE;
+      const int *heights = &heightMaps[chunk * columns];
+
+      std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+      for (int column = 0; column < columns; column++)
+      {
+        int x = baseX + column % WorldConstants::CHUNK_SIZE;
+        int z = baseZ + column / WorldConstants::CHUNK_SIZE;
+
+        for (int y = 0; y < WorldConstants::CHUNK_HEIGHT; y++)
+          voxelBlocks[column * WorldConstants::CHUNK_HEIGHT + y] = static_cast<uint8_t>(TerrainGeneration::GetBlockAtHeight(x, y, z, heights[column]));
+      }
+
+      std::chrono::steady_clock::time_point middle = std::chrono::steady_clock::now();
+
+      for (int column = 0; column < columns; column++)
+      {
+        int x = baseX + column % WorldConstants::CHUNK_SIZE;
+        int z = baseZ + column / WorldConstants::CHUNK_SIZE;
+
+        TerrainGeneration::FillColumn(x, z, heights[column], &columnBlocks[column * WorldConstants::CHUNK_HEIGHT]);
+      }
+
+      std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+      voxelTime += std::chrono::duration<float, std::milli>(middle - begin).count();
+      columnTime += std::chrono::duration<float, std::milli>(end - middle).count();
+
+      for (int block = 0; block < chunkBlocks; block++)
+        mismatches += voxelBlocks[block] != columnBlocks[block];
+    }
+
+    voxelMilliseconds = std::min(voxelMilliseconds, voxelTime);
+    columnMilliseconds = std::min(columnMilliseconds, columnTime);
+  }
+
+  printf("Fill benchmark: %d chunks, best of %d runs \n", chunkCount, repetitions);
+  printf("Per-voxel fill: %.1f ms (%.3f ms per chunk) \n", voxelMilliseconds, voxelMilliseconds / chunkCount);
+  printf("Column fill: %.1f ms (%.3f ms per chunk), %.1fx faster \n", columnMilliseconds, columnMilliseconds / chunkCount, voxelMilliseconds / std::max(columnMilliseconds, 0.001f));
+
+  if (mismatches > 0)
+  {
+    fprintf(stderr, "ERROR: Column fill differs from per-voxel fill in %ld blocks.\n", mismatches);
+    return EXIT_FAILURE;
+  }
+
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  Profiler::SetThreadName("Main");
+
+  // --headless [frames] [trace.json]: roda sem janela, com o backend nulo
+  if (argc > 1 && strcmp(argv[1], "--headless") == 0)
+    return RunHeadless(argc > 2 ? atoi(argv[2]) : 600, argc > 3 ? argv[3] : nullptr);
+
+  // --benchmark-fill [chunks por eixo]: mede o preenchimento do terreno, sem janela nem GPU
+  if (argc > 1 && strcmp(argv[1], "--benchmark-fill") == 0)
+    return RunFillBenchmark(argc > 2 ? atoi(argv[2]) : 16);
+
   if (!Window::Init())
   {
     fprintf(stderr, "ERROR: Window initialization failed.\n");
@@ -64,21 +287,29 @@ int main()
     Shader objectShader("extras/shaders/Object.shader");
     Shader basicShader("extras/shaders/Basic.shader");
 
+    UserInterface::Init(&interfaceShader);
+
+    UniformBuffer frameUniforms(sizeof(FrameConstants));
+    frameUniforms.BindBase(Shader::FRAME_BLOCK_BINDING);
+
     Camera camera(-0.1f, -1024.0f, 60.0f);
     Character player(&basicShader, glm::vec4(0.0f, 64.0f, -3.0f, 1.0f));
 
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_CULL_FACE);
+    GLState::SetEnabled(GL_DEPTH_TEST, true);
+    GLState::SetEnabled(GL_CULL_FACE, true);
 
     std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
 
-    World world(&worldShader);
-
-    world.UpdateMeshes();
+    World world(&worldShader, camera.GetPosition());
 
     std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
 
     printf("Elapsed time: %f \n", (float)std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count());
+    printf("Voxel memory: %.2f MiB \n", world.GetMemoryUsage() / (1024.0f * 1024.0f));
+    printf("Mesh vertices: %d \n", (int)world.GetVertexCount());
+    printf("Mesh memory: %.2f MiB (%.2f MiB unpacked) \n", world.GetMeshMemoryUsage() / (1024.0f * 1024.0f), world.GetUnpackedMeshMemoryUsage() / (1024.0f * 1024.0f));
+
+    PrintArenaStats(world.GetArenaStats());
 
     Input::RegisterMouseButtonCallback(std::bind(&Character::OnClick, &player, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
     Input::RegisterKeyCallback(std::bind(&Character::OnKeypress, &player, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4));
@@ -88,15 +319,62 @@ int main()
 
     bool isGouraud = false;
 
+    // Todos os desenhos do frame passam pela fila, executada uma vez no fim
+    RenderQueue renderQueue(-camera.GetFarplane());
+    GLRenderBackend glBackend;
+
+    // As estatísticas são impressas uma vez por segundo, para a escrita no console não pesar em todo frame
+    std::chrono::steady_clock::time_point lastReport = std::chrono::steady_clock::now();
+    int reportFrames = 0;
+
     while (!Window::GetShouldClose())
     {
+      // Eventos do frame anterior
+      Profiler::Collect();
+
+      PROFILE_ZONE("Frame");
+
       Window::Tick();
 
       renderer.Clear();
 
-      float fps = Window::GetFPS();
+      reportFrames++;
+
+      float reportSeconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - lastReport).count();
+
+      if (reportSeconds >= 1.0f)
+      {
+        const CullingStats &culling = world.GetCullingStats();
+
+        printf("FPS: %f (chunks: %d visible, %d culled, %d unreachable, %d occluded; sections: %d visible, %d culled, %d unreachable, %d occluded, %.1f%% occluded, %d traversed) \n", reportFrames / reportSeconds, culling.visibleChunks, culling.culledChunks, culling.unreachableChunks, culling.occludedChunks, culling.visibleSections, culling.culledSections, culling.unreachableSections, culling.occludedSections, culling.GetOccludedPercentage(), culling.traversedSections);
+
+        const RenderPassStats &opaquePass = world.GetPassStats(DP_OPAQUE);
+        const RenderPassStats &transparentPass = world.GetPassStats(DP_TRANSPARENT);
+
+        // Execução da fila no frame anterior
+        const RenderQueueStats &queueStats = renderQueue.GetStats();
 
-      printf("FPS: %f \n", fps);
+        printf("Passes: opaque %d draws, %d sections, %d vertices, %d state changes; transparent %d draws, %d sections, %d vertices, %d state changes; interface %d state changes \n", opaquePass.drawCalls, opaquePass.ranges, opaquePass.vertices, queueStats.passStateChanges[DP_OPAQUE], transparentPass.drawCalls, transparentPass.ranges, transparentPass.vertices, queueStats.passStateChanges[DP_TRANSPARENT], queueStats.passStateChanges[DP_INTERFACE]);
+        printf("Render queue: %d packets, %d draws, %d state changes, %d elided \n", queueStats.packets, queueStats.drawCalls, queueStats.stateChanges, queueStats.elidedStateChanges);
+
+        // Mudanças de estado do frame anterior, enviadas ao driver e descartadas pelo cache
+        const GLStateStats &glState = GLState::GetStats();
+
+        printf("GL state: %d issued, %d elided \n", glState.issued, glState.elided);
+
+        PrintZoneStats();
+
+        lastReport = std::chrono::steady_clock::now();
+        reportFrames = 0;
+      }
+
+      GLState::ResetStats();
+
+      // Captura os próximos frames em um trace para o chrome://tracing
+      if (Input::IsKeyPressed(GLFW_KEY_F2) && !Profiler::IsCapturing())
+      {
+        Profiler::StartCapture(300, "trace.json");
+      }
 
       if (Input::IsKeyPressed(GLFW_KEY_O))
       {
@@ -110,12 +388,12 @@ int main()
 
       if (Input::IsKeyPressed(GLFW_KEY_V))
       {
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+        renderQueue.SetWireframe(true);
       }
 
       if (Input::IsKeyPressed(GLFW_KEY_B))
       {
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        renderQueue.SetWireframe(false);
       }
 
       if (Input::IsKeyPressed(GLFW_KEY_H))
@@ -138,21 +416,79 @@ int main()
         isGouraud = false;
       }
 
+      // Alterna entre o greedy meshing e o meshing de uma face por bloco para comparar
+      if (Input::IsKeyPressed(GLFW_KEY_M) && world.GetMeshingMode() != MM_GREEDY)
+      {
+        world.SetMeshingMode(MM_GREEDY);
+        printf("Greedy meshing: %d vertices, %.2f MiB \n", (int)world.GetVertexCount(), world.GetMeshMemoryUsage() / (1024.0f * 1024.0f));
+        PrintArenaStats(world.GetArenaStats());
+      }
+
+      if (Input::IsKeyPressed(GLFW_KEY_N) && world.GetMeshingMode() != MM_NAIVE)
+      {
+        world.SetMeshingMode(MM_NAIVE);
+        printf("Naive meshing: %d vertices, %.2f MiB \n", (int)world.GetVertexCount(), world.GetMeshMemoryUsage() / (1024.0f * 1024.0f));
+        PrintArenaStats(world.GetArenaStats());
+      }
+
+      // Liga e desliga o occlusion culling para comparar
+      if (Input::IsKeyPressed(GLFW_KEY_Z))
+      {
+        world.SetOcclusionCulling(true);
+      }
+
+      if (Input::IsKeyPressed(GLFW_KEY_X))
+      {
+        world.SetOcclusionCulling(false);
+      }
+
+      // Liga e desliga o cave culling para comparar
+      if (Input::IsKeyPressed(GLFW_KEY_T))
+      {
+        world.SetCaveCulling(true);
+      }
+
+      if (Input::IsKeyPressed(GLFW_KEY_Y))
+      {
+        world.SetCaveCulling(false);
+      }
+
       player.Update(&camera, &world);
 
-      world.Draw(&camera, camera.ComputeViewMatrix(), camera.ComputeProjectionMatrix());
+      uint64_t editVoxelsVisited = world.GetEditVoxelsVisited();
+
+      world.Update(camera.GetPosition());
+
+      // Custo de reconstruir as meshes das seções afetadas pelas edições de blocos
+      if (world.GetEditVoxelsVisited() != editVoxelsVisited)
+        printf("Edit remeshing: %d voxels visited (%.0f per edit on average) \n", (int)(world.GetEditVoxelsVisited() - editVoxelsVisited), (float)world.GetEditVoxelsVisited() / world.GetEditCount());
+
+      // Matrizes da câmera calculadas uma vez e enviadas a todos os shaders pelo bloco Frame
+      glm::mat4 view = camera.ComputeViewMatrix();
+      glm::mat4 projection = camera.ComputeProjectionMatrix();
+
+      FrameConstants frame = {view, projection, glm::inverse(view)[3]};
+      frameUniforms.SetData(&frame);
+
+      renderQueue.Clear();
+
+      world.Draw(renderQueue, &camera, view, projection);
 
       if (!camera.IsFreeCamera())
       {
-        player.Draw(&camera, camera.ComputeViewMatrix(), camera.ComputeProjectionMatrix());
+        player.Draw(renderQueue, &camera);
       }
 
-      cow.Draw(&objectShader, camera.ComputeViewMatrix(), camera.ComputeProjectionMatrix(), isGouraud);
+      cow.Draw(renderQueue, &objectShader, camera.GetPosition(), isGouraud);
 
-      UserInterface::DrawUI(&interfaceShader, world.GetTextureAtlas(), player.GetHotbarPosition());
+      UserInterface::DrawUI(renderQueue, &interfaceShader, world.GetTextureAtlas(), player.GetHotbarPosition());
+
+      renderQueue.Execute(glBackend);
 
       Window::EndFrame();
     }
+
+    UserInterface::Terminate();
   }
 
   Window::Terminate();
@@ -43,35 +43,17 @@ namespace Collisions
     {
       glm::vec3 corner = bboxCorners[i];
 
-      // Calcula qual chunk e bloco a posição do canto está
-      int bboxChunkX = (int)floorf(corner.x / WorldConstants::CHUNK_SIZE);
-      int bboxChunkZ = (int)floorf(corner.z / WorldConstants::CHUNK_SIZE);
+      int maxBboxBlockY = (int)floorf(corner.y);
+      int minBboxBlockY = (int)ceilf(corner.y - entitySize.y);
 
-      // Se está em uma posição válida
-      if (bboxChunkX >= 0 && bboxChunkX < WorldConstants::CHUNKS_PER_AXIS && bboxChunkZ >= 0 && bboxChunkZ < WorldConstants::CHUNKS_PER_AXIS)
+      // Testa se há um bloco sólido na posição do canto
+      for (int y = maxBboxBlockY; y >= minBboxBlockY; y--)
       {
-        Chunk *chunk = world->GetChunk(bboxChunkX, bboxChunkZ);
+        int block = world->GetBlock(glm::vec3(corner.x, y, corner.z));
 
-        int bboxBlockX = ((int)floorf(corner.x)) % WorldConstants::CHUNK_SIZE;
-        int bboxBlockZ = ((int)floorf(corner.z)) % WorldConstants::CHUNK_SIZE;
-
-        int maxBboxBlockY = (int)floorf(corner.y);
-        int minBboxBlockY = (int)ceilf(corner.y - entitySize.y);
-
-        // Testa se há um bloco sólido na posição do canto
-        if (bboxBlockX >= 0 && bboxBlockX < WorldConstants::CHUNK_SIZE && bboxBlockZ >= 0 && bboxBlockZ < WorldConstants::CHUNK_SIZE)
+        if (BlockDatabase::IsSolid(block))
         {
-          for (int y = maxBboxBlockY; y >= minBboxBlockY; y--)
-          {
-            int block = chunk->GetCube(glm::vec3(bboxBlockX, y, bboxBlockZ));
-
-            BlockInformation blockInfo = BlockDatabase::GetBlockInformationIndex(block);
-
-            if (blockInfo.isSolid)
-            {
-              return true;
-            }
-          }
+          return true;
         }
       }
     }
@@ -83,30 +65,12 @@ namespace Collisions
   // Testa colisão entre um ponto e o mundo
   bool PointWorldCollision(glm::vec3 point, World *world)
   {
-    int pointChunkX = (int)floorf(point.x / WorldConstants::CHUNK_SIZE);
-    int pointChunkZ = (int)floorf(point.z / WorldConstants::CHUNK_SIZE);
+    // Testa se há um bloco sólido na posição do ponto
+    int block = world->GetBlock(point);
 
-    if (pointChunkX >= 0 && pointChunkX < WorldConstants::CHUNKS_PER_AXIS && pointChunkZ >= 0 && pointChunkZ < WorldConstants::CHUNKS_PER_AXIS)
+    if (BlockDatabase::IsSolid(block))
     {
-      Chunk *chunk = world->GetChunk(pointChunkX, pointChunkZ);
-
-      int pointBlockX = ((int)floorf(point.x)) % WorldConstants::CHUNK_SIZE;
-      int pointBlockZ = ((int)floorf(point.z)) % WorldConstants::CHUNK_SIZE;
-
-      int pointBlockY = (int)floorf(point.y);
-
-      // Se o ponto está em uma posição válida, testa se há um bloco sólido na posição
-      if (pointBlockX >= 0 && pointBlockX < WorldConstants::CHUNK_SIZE && pointBlockZ >= 0 && pointBlockZ < WorldConstants::CHUNK_SIZE)
-      {
-        int block = chunk->GetCube(glm::vec3(pointBlockX, pointBlockY, pointBlockZ));
-
-        BlockInformation blockInfo = BlockDatabase::GetBlockInformationIndex(block);
-
-        if (blockInfo.isSolid)
-        {
-          return true;
-        }
-      }
+      return true;
     }
 
     // Se não detectou nehuma colisão, retorna falso
@@ -0,0 +1,289 @@
+#include <cstring>
+
+#include "world/BlockStorage.hpp"
+
+// Inicializa o armazenamento com todos os voxels iguais a um bloco
+BlockStorage::BlockStorage(int size, int initialBlock)
+    : m_Size(size),
+      m_BitsPerBlock(0),
+      m_BlocksPerWordShift(0),
+      m_IndexMask(0)
+{
+  Fill(initialBlock);
+}
+
+// Atualiza o bloco de um voxel, aumentando a paleta se necessário
+void BlockStorage::Set(int index, int block)
+{
+  int oldPaletteIndex = GetPaletteIndex(index);
+
+  if (m_Palette[oldPaletteIndex] == block)
+    return;
+
+  int paletteIndex = m_PaletteLookup[block];
+
+  if (paletteIndex == NOT_IN_PALETTE)
+    paletteIndex = AddToPalette(block);
+
+  m_PaletteCounts[oldPaletteIndex]--;
+  m_PaletteCounts[paletteIndex]++;
+
+  SetPaletteIndex(index, paletteIndex);
+}
+
+void BlockStorage::SetPaletteIndex(int index, int paletteIndex)
+{
+  if (m_BitsPerBlock == 0)
+    return;
+
+  uint64_t &word = m_Data[index >> m_BlocksPerWordShift];
+  int shift = (index & ((1 << m_BlocksPerWordShift) - 1)) * m_BitsPerBlock;
+
+  word = (word & ~(m_IndexMask << shift)) | (static_cast<uint64_t>(paletteIndex) << shift);
+}
+
+// Adiciona um bloco na paleta e aumenta a quantidade de bits por voxel quando ela não cabe mais
+int BlockStorage::AddToPalette(int block)
+{
+  // Reaproveita uma entrada que não é mais usada por nenhum voxel
+  for (size_t i = 0; i < m_Palette.size(); i++)
+  {
+    if (m_PaletteCounts[i] == 0)
+    {
+      m_PaletteLookup[m_Palette[i]] = NOT_IN_PALETTE;
+
+      m_Palette[i] = block;
+      m_PaletteLookup[block] = static_cast<uint8_t>(i);
+
+      return static_cast<int>(i);
+    }
+  }
+
+  int paletteIndex = static_cast<int>(m_Palette.size());
+
+  m_Palette.push_back(block);
+  m_PaletteCounts.push_back(0);
+  m_PaletteLookup[block] = static_cast<uint8_t>(paletteIndex);
+
+  if (m_Palette.size() > (size_t(1) << m_BitsPerBlock))
+  {
+    int bitsPerBlock = m_BitsPerBlock == 0 ? 1 : m_BitsPerBlock * 2;
+
+    if (bitsPerBlock > MAX_BITS_PER_BLOCK)
+      bitsPerBlock = MAX_BITS_PER_BLOCK;
+
+    Resize(bitsPerBlock);
+  }
+
+  return paletteIndex;
+}
+
+// Reempacota os índices com a nova quantidade de bits por voxel
+void BlockStorage::Resize(int bitsPerBlock)
+{
+  if (bitsPerBlock == 0)
+  {
+    SetLayout(0);
+    return;
+  }
+
+  std::vector<uint8_t> indices(m_Size);
+
+  for (int i = 0; i < m_Size; i++)
+    indices[i] = static_cast<uint8_t>(GetPaletteIndex(i));
+
+  SetLayout(bitsPerBlock);
+
+  for (int i = 0; i < m_Size; i++)
+    SetPaletteIndex(i, indices[i]);
+}
+
+// Define a quantidade de bits por voxel e zera os índices
+void BlockStorage::SetLayout(int bitsPerBlock)
+{
+  m_BitsPerBlock = bitsPerBlock;
+  m_BlocksPerWordShift = 0;
+  m_IndexMask = 0;
+
+  if (bitsPerBlock == 0)
+  {
+    m_Data.clear();
+    m_Data.shrink_to_fit();
+    return;
+  }
+
+  int blocksPerWord = 64 / bitsPerBlock;
+
+  while ((1 << m_BlocksPerWordShift) < blocksPerWord)
+    m_BlocksPerWordShift++;
+
+  m_IndexMask = (uint64_t(1) << bitsPerBlock) - 1;
+
+  m_Data.assign((m_Size + blocksPerWord - 1) / blocksPerWord, 0);
+  m_Data.shrink_to_fit();
+}
+
+void BlockStorage::Fill(int block)
+{
+  m_PaletteLookup.fill(NOT_IN_PALETTE);
+
+  m_Palette.assign(1, block);
+  m_PaletteCounts.assign(1, m_Size);
+  m_PaletteLookup[block] = 0;
+
+  Resize(0);
+}
+
+void BlockStorage::Load(const uint8_t *blocks)
+{
+  m_PaletteLookup.fill(NOT_IN_PALETTE);
+
+  m_Palette.clear();
+  m_PaletteCounts.clear();
+
+  // Primeira passada: monta a paleta e a ocupação de cada entrada, contando por sequências de blocos iguais
+  for (int i = 0; i < m_Size;)
+  {
+    int block = blocks[i];
+    int start = i;
+
+    while (i < m_Size && blocks[i] == block)
+      i++;
+
+    int paletteIndex = m_PaletteLookup[block];
+
+    if (paletteIndex == NOT_IN_PALETTE)
+    {
+      paletteIndex = static_cast<int>(m_Palette.size());
+
+      m_Palette.push_back(block);
+      m_PaletteCounts.push_back(0);
+      m_PaletteLookup[block] = static_cast<uint8_t>(paletteIndex);
+    }
+
+    m_PaletteCounts[paletteIndex] += i - start;
+  }
+
+  int bitsPerBlock = 0;
+
+  while ((size_t(1) << bitsPerBlock) < m_Palette.size())
+    bitsPerBlock = bitsPerBlock == 0 ? 1 : bitsPerBlock * 2;
+
+  SetLayout(bitsPerBlock);
+
+  if (m_BitsPerBlock == 0)
+    return;
+
+  // Segunda passada: empacota palavra por palavra, sem ler e reescrever cada palavra por voxel
+  int blocksPerWord = 1 << m_BlocksPerWordShift;
+
+  for (size_t word = 0; word < m_Data.size(); word++)
+  {
+    uint64_t packed = 0;
+    int first = static_cast<int>(word) * blocksPerWord;
+    int count = m_Size - first < blocksPerWord ? m_Size - first : blocksPerWord;
+
+    for (int i = 0; i < count; i++)
+      packed |= static_cast<uint64_t>(m_PaletteLookup[blocks[first + i]]) << (i * m_BitsPerBlock);
+
+    m_Data[word] = packed;
+  }
+}
+
+void BlockStorage::Compact()
+{
+  std::vector<int> remap(m_Palette.size(), 0);
+
+  std::vector<int> palette;
+  std::vector<int> counts;
+
+  for (size_t i = 0; i < m_Palette.size(); i++)
+  {
+    if (m_PaletteCounts[i] > 0)
+    {
+      remap[i] = static_cast<int>(palette.size());
+      palette.push_back(m_Palette[i]);
+      counts.push_back(m_PaletteCounts[i]);
+    }
+  }
+
+  int bitsPerBlock = 0;
+
+  while ((size_t(1) << bitsPerBlock) < palette.size())
+    bitsPerBlock = bitsPerBlock == 0 ? 1 : bitsPerBlock * 2;
+
+  if (palette.size() == m_Palette.size() && bitsPerBlock == m_BitsPerBlock)
+    return;
+
+  std::vector<uint8_t> indices(m_Size);
+
+  for (int i = 0; i < m_Size; i++)
+    indices[i] = static_cast<uint8_t>(remap[GetPaletteIndex(i)]);
+
+  m_PaletteLookup.fill(NOT_IN_PALETTE);
+
+  for (size_t i = 0; i < palette.size(); i++)
+    m_PaletteLookup[palette[i]] = static_cast<uint8_t>(i);
+
+  m_Palette = palette;
+  m_PaletteCounts = counts;
+
+  SetLayout(bitsPerBlock);
+
+  for (int i = 0; i < m_Size; i++)
+    SetPaletteIndex(i, indices[i]);
+}
+
+// Serializa a paleta e os índices empacotados
+void BlockStorage::Serialize(std::vector<uint8_t> &out) const
+{
+  out.push_back(static_cast<uint8_t>(m_Palette.size() - 1));
+
+  for (int block : m_Palette)
+    out.push_back(static_cast<uint8_t>(block));
+
+  out.push_back(static_cast<uint8_t>(m_BitsPerBlock));
+
+  size_t offset = out.size();
+  out.resize(offset + m_Data.size() * sizeof(uint64_t));
+
+  if (!m_Data.empty())
+    memcpy(&out[offset], m_Data.data(), m_Data.size() * sizeof(uint64_t));
+}
+
+// Carrega o armazenamento serializado e retorna a quantidade de bytes lidos
+size_t BlockStorage::Deserialize(const uint8_t *data)
+{
+  size_t read = 0;
+
+  int paletteSize = data[read++] + 1;
+
+  m_Palette.resize(paletteSize);
+  m_PaletteLookup.fill(NOT_IN_PALETTE);
+
+  for (int i = 0; i < paletteSize; i++)
+  {
+    m_Palette[i] = data[read++];
+    m_PaletteLookup[m_Palette[i]] = static_cast<uint8_t>(i);
+  }
+
+  SetLayout(data[read++]);
+
+  if (!m_Data.empty())
+    memcpy(m_Data.data(), data + read, m_Data.size() * sizeof(uint64_t));
+
+  read += m_Data.size() * sizeof(uint64_t);
+
+  // Recalcula a ocupação de cada entrada da paleta
+  m_PaletteCounts.assign(paletteSize, 0);
+
+  for (int i = 0; i < m_Size; i++)
+    m_PaletteCounts[GetPaletteIndex(i)]++;
+
+  return read;
+}
+
+size_t BlockStorage::GetMemoryUsage() const
+{
+  return sizeof(BlockStorage) + m_Palette.capacity() * sizeof(int) + m_PaletteCounts.capacity() * sizeof(int) + m_Data.capacity() * sizeof(uint64_t);
+}
@@ -1,7 +1,11 @@
+#include <cstdio>
+
 #include <glm/glm.hpp>
 #include <glm/gtc/noise.hpp>
 #include "core.h"
 
+#include "core/Profiler.hpp"
+
 #include "world/Chunk.hpp"
 
 #include "world/Noise.hpp"
@@ -12,243 +16,235 @@
 Chunk::Chunk(int chunkX, int chunkZ)
     : m_ChunkX(chunkX),
       m_ChunkZ(chunkZ),
-      m_VAO(NULL),
-      m_VBO(NULL),
-      m_TransparentVAO(NULL),
-      m_TransparentVBO(NULL)
+      m_Bounds(1, 0)
 {
-  std::array<int, WorldConstants::CHUNK_SIZE * WorldConstants::CHUNK_SIZE> heightMap;
-
-  // Calcula o heightmap para cada posição horizontal do chunk
-  for (int z = 0; z < WorldConstants::CHUNK_SIZE; z++)
-  {
-    for (int x = 0; x < WorldConstants::CHUNK_SIZE; x++)
-    {
-      heightMap[x + z * WorldConstants::CHUNK_SIZE] = TerrainGeneration::GetHeight(glm::vec2(x, z), glm::vec2(chunkX, chunkZ));
-    }
-  }
+  PROFILE_ZONE("TerrainGeneration");
 
-  // Gera o bloco para cada posição do chunk
-  for (int x = 0; x < WorldConstants::CHUNK_SIZE; x++)
-  {
-    for (int z = 0; z < WorldConstants::CHUNK_SIZE; z++)
-    {
-      for (int y = 0; y < WorldConstants::CHUNK_HEIGHT; y++)
-      {
-        int block = TerrainGeneration::GetBlockAtHeight(y, heightMap[x + z * WorldConstants::CHUNK_SIZE]);
-        m_Cubes[x][y][z] = block;
-      }
-    }
-  }
-}
+  m_SectionBounds.fill(glm::ivec2(1, 0));
+  m_SectionConnectivity.fill(SectionVisibility::ALL_CONNECTED);
 
-Chunk::~Chunk()
-{
-  if (m_VAO != NULL)
-    delete m_VAO;
+  const int columns = WorldConstants::CHUNK_SIZE * WorldConstants::CHUNK_SIZE;
 
-  if (m_VBO != NULL)
-    delete m_VBO;
+  std::array<int, columns> heightMap;
 
-  if (m_TransparentVAO != NULL)
-    delete m_TransparentVAO;
+  // Calcula o heightmap de todas as posições horizontais do chunk
+  TerrainGeneration::GetHeightMap(chunkX, chunkZ, heightMap.data());
 
-  if (m_TransparentVBO != NULL)
-    delete m_TransparentVBO;
-}
+  int maxHeight = WorldConstants::WATER_LEVEL;
 
-// Constrói a mesh do chunk
-void Chunk::BuildMesh(std::array<Chunk *, 4> neighbors)
-{
-  if (m_VAO != NULL)
-  {
-    delete m_VAO;
-  }
+  for (int height : heightMap)
+    maxHeight = glm::max(maxHeight, height);
 
-  m_VAO = new VertexArray();
+  // Preenche cada coluna por faixas em um buffer temporário, reaproveitado entre chunks da mesma thread
+  static thread_local std::vector<uint8_t> columnBlocks;
+  columnBlocks.resize(columns * WorldConstants::CHUNK_HEIGHT);
 
-  if (m_TransparentVAO != NULL)
+  for (int z = 0; z < WorldConstants::CHUNK_SIZE; z++)
   {
-    delete m_TransparentVAO;
-  }
+    for (int x = 0; x < WorldConstants::CHUNK_SIZE; x++)
+    {
+      int column = x + z * WorldConstants::CHUNK_SIZE;
 
-  m_TransparentVAO = new VertexArray();
+      TerrainGeneration::FillColumn(chunkX * WorldConstants::CHUNK_SIZE + x, chunkZ * WorldConstants::CHUNK_SIZE + z, heightMap[column], &columnBlocks[column * WorldConstants::CHUNK_HEIGHT]);
+    }
+  }
 
-  std::vector<CubeVertex> vertices;
-  std::vector<CubeVertex> transparentVertices;
+  // O casco de cada célula vai até o primeiro bloco transparente da coluna mais baixa
+  m_HullHeights.fill(WorldConstants::CHUNK_HEIGHT);
 
-  // Para cada bloco do chunk
-  for (int x = 0; x < WorldConstants::CHUNK_SIZE; x++)
+  for (int column = 0; column < columns; column++)
   {
-    for (int y = 0; y < WorldConstants::CHUNK_HEIGHT; y++)
-    {
-      for (int z = 0; z < WorldConstants::CHUNK_SIZE; z++)
-      {
-        int cube = m_Cubes[x][y][z];
-
-        if (cube != 0)
-        {
-          BlockInformation cubeInfo = BlockDatabase::GetBlockInformationIndex(cube);
+    const uint8_t *blocks = &columnBlocks[column * WorldConstants::CHUNK_HEIGHT];
 
-          bool hasBlockInFront = false;
-          bool hasBlockInRight = false;
-          bool hasBlockInBack = false;
-          bool hasBlockInLeft = false;
-          bool hasBlockInTop = false;
-          bool hasBlockInBottom = false;
+    int solidHeight = 0;
 
-          // Verifica quais faces estão oclusas por blocos opacos e não devem ser renderizadas
-          if (z + 1 < WorldConstants::CHUNK_SIZE)
-          {
-            int blockInFront = m_Cubes[x][y][z + 1];
+    while (solidHeight < WorldConstants::CHUNK_HEIGHT && BlockDatabase::IsOpaque(blocks[solidHeight]))
+      solidHeight++;
 
-            BlockInformation blockInfo = BlockDatabase::GetBlockInformationIndex(blockInFront);
+    int x = column % WorldConstants::CHUNK_SIZE;
+    int z = column / WorldConstants::CHUNK_SIZE;
 
-            hasBlockInFront = cubeInfo.isOpaque ? blockInfo.isOpaque : blockInfo.isOpaque || blockInFront == cube;
-          }
-          else if (neighbors[1] != NULL)
-          {
-            int blockInFront = neighbors[1]->m_Cubes[x][y][0];
+    int &hullHeight = m_HullHeights[(z / HULL_CELL_SIZE) * HULL_CELLS + x / HULL_CELL_SIZE];
 
-            BlockInformation blockInfo = BlockDatabase::GetBlockInformationIndex(blockInFront);
-
-            hasBlockInFront = cubeInfo.isOpaque ? blockInfo.isOpaque : blockInfo.isOpaque || blockInFront == cube;
-          }
+    hullHeight = glm::min(hullHeight, solidHeight);
+  }
 
-          if (x + 1 < WorldConstants::CHUNK_SIZE)
-          {
-            int blockInRight = m_Cubes[x + 1][y][z];
+  // Seções acima do terreno e da água continuam vazias
+  int sectionCount = glm::min(maxHeight / WorldConstants::SECTION_HEIGHT + 1, WorldConstants::SECTIONS_PER_CHUNK);
 
-            BlockInformation blockInfo = BlockDatabase::GetBlockInformationIndex(blockInRight);
+  std::array<uint8_t, ChunkSection::VOLUME> sectionBlocks;
 
-            hasBlockInRight = cubeInfo.isOpaque ? blockInfo.isOpaque : blockInfo.isOpaque || blockInRight == cube;
-          }
-          else if (neighbors[2] != NULL)
-          {
-            int blockInRight = neighbors[2]->m_Cubes[0][y][z];
+  for (int section = 0; section < sectionCount; section++)
+  {
+    // Transpõe as colunas para a ordem da seção, lendo cada trecho de coluna de forma contígua
+    for (int column = 0; column < columns; column++)
+    {
+      const uint8_t *source = &columnBlocks[column * WorldConstants::CHUNK_HEIGHT + section * WorldConstants::SECTION_HEIGHT];
 
-            BlockInformation blockInfo = BlockDatabase::GetBlockInformationIndex(blockInRight);
+      for (int y = 0; y < WorldConstants::SECTION_HEIGHT; y++)
+        sectionBlocks[y * columns + column] = source[y];
+    }
 
-            hasBlockInRight = cubeInfo.isOpaque ? blockInfo.isOpaque : blockInfo.isOpaque || blockInRight == cube;
-          }
+    m_Sections[section].Load(sectionBlocks.data());
+  }
+}
 
-          if (z - 1 >= 0)
-          {
-            int blockInBack = m_Cubes[x][y][z - 1];
+Chunk::~Chunk()
+{
+  for (int section = 0; section < WorldConstants::SECTIONS_PER_CHUNK; section++)
+  {
+    DeleteSectionMesh(m_SectionMeshes[section]);
+    DeleteSectionMesh(m_TransparentSectionMeshes[section]);
+  }
+}
 
-            BlockInformation blockInfo = BlockDatabase::GetBlockInformationIndex(blockInBack);
+void Chunk::Serialize(std::vector<uint8_t> &out) const
+{
+  for (const auto &section : m_Sections)
+  {
+    if (section.IsEmpty())
+    {
+      out.push_back(0);
+      continue;
+    }
 
-            hasBlockInBack = cubeInfo.isOpaque ? blockInfo.isOpaque : blockInfo.isOpaque || blockInBack == cube;
-          }
-          else if (neighbors[3] != NULL)
-          {
-            int blockInBack = neighbors[3]->m_Cubes[x][y][WorldConstants::CHUNK_SIZE - 1];
+    out.push_back(1);
+    section.GetStorage().Serialize(out);
+  }
+}
 
-            BlockInformation blockInfo = BlockDatabase::GetBlockInformationIndex(blockInBack);
+void Chunk::Deserialize(const std::vector<uint8_t> &data)
+{
+  size_t offset = 0;
 
-            hasBlockInBack = cubeInfo.isOpaque ? blockInfo.isOpaque : blockInfo.isOpaque || blockInBack == cube;
-          }
+  for (auto &section : m_Sections)
+  {
+    if (data[offset++] == 0)
+    {
+      section.Fill(AIR);
+      continue;
+    }
 
-          if (x - 1 >= 0)
-          {
-            int blockInLeft = m_Cubes[x - 1][y][z];
+    offset += section.GetStorage().Deserialize(&data[offset]);
+  }
 
-            BlockInformation blockInfo = BlockDatabase::GetBlockInformationIndex(blockInLeft);
+  UpdateHullHeights();
+}
 
-            hasBlockInLeft = cubeInfo.isOpaque ? blockInfo.isOpaque : blockInfo.isOpaque || blockInLeft == cube;
-          }
-          else if (neighbors[0] != NULL)
-          {
-            int blockInLeft = neighbors[0]->m_Cubes[WorldConstants::CHUNK_SIZE - 1][y][z];
+void Chunk::UpdateHullHeights()
+{
+  m_HullHeights.fill(WorldConstants::CHUNK_HEIGHT);
 
-            BlockInformation blockInfo = BlockDatabase::GetBlockInformationIndex(blockInLeft);
+  for (int z = 0; z < WorldConstants::CHUNK_SIZE; z++)
+  {
+    for (int x = 0; x < WorldConstants::CHUNK_SIZE; x++)
+    {
+      int solidHeight = 0;
 
-            hasBlockInLeft = cubeInfo.isOpaque ? blockInfo.isOpaque : blockInfo.isOpaque || blockInLeft == cube;
-          }
+      while (solidHeight < WorldConstants::CHUNK_HEIGHT && BlockDatabase::IsOpaque(GetCube(x, solidHeight, z)))
+        solidHeight++;
 
-          if (y + 1 < WorldConstants::CHUNK_HEIGHT)
-          {
-            int blockInTop = m_Cubes[x][y + 1][z];
+      int &hullHeight = m_HullHeights[(z / HULL_CELL_SIZE) * HULL_CELLS + x / HULL_CELL_SIZE];
 
-            BlockInformation blockInfo = BlockDatabase::GetBlockInformationIndex(blockInTop);
+      hullHeight = glm::min(hullHeight, solidHeight);
+    }
+  }
+}
 
-            hasBlockInTop = cubeInfo.isOpaque ? blockInfo.isOpaque : blockInfo.isOpaque || blockInTop == cube;
-          }
+size_t Chunk::GetMemoryUsage() const
+{
+  size_t memory = 0;
 
-          if (y - 1 >= 0)
-          {
-            int blockInBottom = m_Cubes[x][y - 1][z];
+  for (const auto &section : m_Sections)
+    memory += section.GetMemoryUsage();
 
-            BlockInformation blockInfo = BlockDatabase::GetBlockInformationIndex(blockInBottom);
+  return memory;
+}
 
-            hasBlockInBottom = cubeInfo.isOpaque ? blockInfo.isOpaque : blockInfo.isOpaque || blockInBottom == cube;
-          }
+// A alocação anterior é liberada e os vértices novos ocupam o menor bloco livre da arena que os comporta
+void Chunk::UploadSectionMesh(SectionMesh &mesh, const std::vector<CubeVertex> &vertices)
+{
+  DeleteSectionMesh(mesh);
 
-          std::array<bool, 6> occlusion = {
-              hasBlockInFront,
-              hasBlockInRight,
-              hasBlockInBack,
-              hasBlockInLeft,
-              hasBlockInTop,
-              hasBlockInBottom};
+  // Seções sem faces não ocupam a arena
+  if (vertices.empty())
+    return;
 
-          BlockInformation blockInfo = BlockDatabase::GetBlockInformationIndex(cube);
+  glm::ivec2 origin = glm::ivec2(m_ChunkX * WorldConstants::CHUNK_SIZE, m_ChunkZ * WorldConstants::CHUNK_SIZE);
 
-          // Com a oclusão calculada, gera os vértices do bloco que serão adicionados à mesh
-          std::vector<CubeVertex> visibleVertices = Cube::GetVisibleVertices(cube, glm::vec3(x, y, z), blockInfo.textureCoordinates, occlusion);
+  mesh.allocation = m_VertexArena->Allocate(vertices.data(), static_cast<int>(vertices.size()), origin);
 
-          // Adiciona vértices na geometria correspondente
-          if (blockInfo.isOpaque)
-            vertices.insert(vertices.end(), visibleVertices.begin(), visibleVertices.end());
-          else
-            transparentVertices.insert(transparentVertices.end(), visibleVertices.begin(), visibleVertices.end());
-        }
-      }
-    }
+  // A seção fica sem essa mesh até o próximo envio; a falha também é contada nas estatísticas da arena
+  if (mesh.allocation == BufferAllocator::INVALID)
+  {
+    fprintf(stderr, "ERROR: Vertex arena is full, dropped a mesh of %d vertices in chunk (%d, %d).\n", static_cast<int>(vertices.size()), m_ChunkX, m_ChunkZ);
+    return;
   }
 
-  // Atualiza a geometria do chunk
+  mesh.vertexCount = static_cast<int>(vertices.size());
+}
 
-  if (m_VBO != NULL)
-    delete m_VBO;
+void Chunk::DeleteSectionMesh(SectionMesh &mesh)
+{
+  if (mesh.allocation != BufferAllocator::INVALID)
+    m_VertexArena->Free(mesh.allocation);
 
-  if (m_TransparentVBO != NULL)
-    delete m_TransparentVBO;
+  mesh = SectionMesh();
+}
 
-  m_VBO = new VertexBuffer(&vertices[0], vertices.size() * sizeof(CubeVertex));
-  m_TransparentVBO = new VertexBuffer(&transparentVertices[0], transparentVertices.size() * sizeof(CubeVertex));
+// Envia a mesh gerada de uma seção para a GPU
+void Chunk::UploadMesh(VertexArena *arena, int section, const std::vector<CubeVertex> &vertices, const std::vector<CubeVertex> &transparentVertices, glm::ivec2 verticalBounds, uint16_t connectivity)
+{
+  m_VertexArena = arena;
 
-  VertexBufferLayout *layout = new VertexBufferLayout();
+  UploadSectionMesh(m_SectionMeshes[section], vertices);
+  UploadSectionMesh(m_TransparentSectionMeshes[section], transparentVertices);
 
-  layout->Push(LayoutType::LT_FLOAT, 4);
-  layout->Push(LayoutType::LT_FLOAT, 2);
-  layout->Push(LayoutType::LT_FLOAT, 4);
+  m_SectionBounds[section] = verticalBounds;
+  m_SectionConnectivity[section] = connectivity;
 
-  m_VAO->AddBuffer(*m_VBO, *layout);
-  m_TransparentVAO->AddBuffer(*m_TransparentVBO, *layout);
+  // Os limites do chunk são a união dos limites das seções com vértices
+  m_Bounds = glm::ivec2(WorldConstants::CHUNK_HEIGHT, 0);
 
-  m_MeshVertexCount = vertices.size();
-  m_TransparentMeshVertexCount = transparentVertices.size();
+  for (glm::ivec2 bounds : m_SectionBounds)
+    if (bounds.x <= bounds.y)
+      m_Bounds = glm::ivec2(glm::min(m_Bounds.x, bounds.x), glm::max(m_Bounds.y, bounds.y));
+
+  m_HasMesh = true;
 }
 
-// Desenha o chunk
-void Chunk::Draw(Shader *shader)
+int Chunk::GetVertexCount() const
 {
-  shader->SetUniform1i("uIsOpaque", 1);
+  if (!m_HasMesh)
+    return 0;
 
-  m_VAO->Bind();
+  int vertexCount = 0;
 
-  glDrawArrays(GL_TRIANGLES, 0, m_MeshVertexCount);
+  for (int section = 0; section < WorldConstants::SECTIONS_PER_CHUNK; section++)
+    vertexCount += m_SectionMeshes[section].vertexCount + m_TransparentSectionMeshes[section].vertexCount;
 
-  // Ativa transparência para desenhar a geometria transparente
-  glEnable(GL_BLEND);
-  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  return vertexCount;
+}
 
-  shader->SetUniform1i("uIsOpaque", 0);
+void Chunk::AddOpaqueDraws(uint16_t sections, const SectionOrder &order, DrawList &draws) const
+{
+  for (int section : order)
+  {
+    const SectionMesh &mesh = m_SectionMeshes[section];
 
-  m_TransparentVAO->Bind();
+    if ((sections & (1 << section)) && mesh.vertexCount > 0)
+      draws.Add(m_VertexArena->GetFirst(mesh.allocation), mesh.vertexCount);
+  }
+}
 
-  glDrawArrays(GL_TRIANGLES, 0, m_TransparentMeshVertexCount);
+void Chunk::AddTransparentDraws(uint16_t sections, const SectionOrder &order, DrawList &draws) const
+{
+  for (int i = WorldConstants::SECTIONS_PER_CHUNK - 1; i >= 0; i--)
+  {
+    int section = order[i];
+    const SectionMesh &mesh = m_TransparentSectionMeshes[section];
 
-  glDisable(GL_BLEND);
+    if ((sections & (1 << section)) && mesh.vertexCount > 0)
+      draws.Add(m_VertexArena->GetFirst(mesh.allocation), mesh.vertexCount);
+  }
 }
@@ -0,0 +1,250 @@
+#include <glm/glm.hpp>
+
+#include "world/ChunkMesher.hpp"
+
+#include "core/Profiler.hpp"
+
+#include "world/BlockDatabase.hpp"
+
+// Copia as seções do chunk e a camada de blocos de cada vizinho que encosta nele
+// As seções vazias dos vizinhos não precisam ser lidas bloco a bloco
+ChunkSnapshot::ChunkSnapshot(const Chunk &chunk, const std::array<Chunk *, 4> &neighbors, uint16_t sections)
+{
+  const int size = WorldConstants::CHUNK_SIZE;
+
+  // As faces de cima e de baixo dependem das seções adjacentes
+  uint16_t copiedSections = sections | (sections << 1) | (sections >> 1);
+
+  for (int section = 0; section < WorldConstants::SECTIONS_PER_CHUNK; section++)
+    if (copiedSections & (1 << section))
+      m_Sections[section] = chunk.GetSection(section);
+
+  for (int side = 0; side < 4; side++)
+  {
+    Chunk *neighbor = neighbors[side];
+
+    m_Borders[side].fill(AIR);
+    m_IsNeighborSectionOpaque[side].fill(false);
+
+    if (neighbor == NULL)
+      continue;
+
+    for (int section = 0; section < WorldConstants::SECTIONS_PER_CHUNK; section++)
+    {
+      const ChunkSection &neighborSection = neighbor->GetSection(section);
+
+      if (!(sections & (1 << section)) || neighborSection.IsEmpty())
+        continue;
+
+      m_IsNeighborSectionOpaque[side][section] = neighborSection.IsUniformOpaque();
+
+      for (int y = 0; y < WorldConstants::SECTION_HEIGHT; y++)
+      {
+        uint8_t *row = &m_Borders[side][(section * WorldConstants::SECTION_HEIGHT + y) * size];
+
+        for (int i = 0; i < size; i++)
+        {
+          // Lado esquerdo e direito variam em z; frente e trás variam em x
+          int x = side == 0 ? size - 1 : side == 2 ? 0
+                                                   : i;
+          int z = side == 1 ? 0 : side == 3 ? size - 1
+                                            : i;
+
+          row[i] = static_cast<uint8_t>(neighborSection.GetCube(x, y, z));
+        }
+      }
+    }
+  }
+}
+
+bool ChunkSnapshot::CanSkipSection(int section) const
+{
+  const ChunkSection &current = m_Sections[section];
+
+  if (current.IsEmpty())
+    return true;
+
+  if (!current.IsUniformOpaque())
+    return false;
+
+  // Faces no topo e na base do mundo são sempre visíveis
+  if (section == 0 || section == WorldConstants::SECTIONS_PER_CHUNK - 1)
+    return false;
+
+  if (!m_Sections[section - 1].IsUniformOpaque() || !m_Sections[section + 1].IsUniformOpaque())
+    return false;
+
+  for (int side = 0; side < 4; side++)
+    if (!m_IsNeighborSectionOpaque[side][section])
+      return false;
+
+  return true;
+}
+
+void ChunkMesher::BuildNaiveMesh(const ChunkSnapshot &snapshot, int section, std::vector<CubeVertex> &vertices, std::vector<CubeVertex> &transparentVertices)
+{
+  int minY = section * WorldConstants::SECTION_HEIGHT;
+  int maxY = minY + WorldConstants::SECTION_HEIGHT;
+
+  // Para cada bloco da seção
+  for (int x = 0; x < WorldConstants::CHUNK_SIZE; x++)
+  {
+    for (int y = minY; y < maxY; y++)
+    {
+      for (int z = 0; z < WorldConstants::CHUNK_SIZE; z++)
+      {
+        int cube = snapshot.GetCube(x, y, z);
+
+        if (cube == AIR)
+          continue;
+
+        // Verifica quais faces estão oclusas pelos vizinhos e não devem ser renderizadas
+        std::array<bool, 6> occlusion = {
+            Cube::IsFaceOccluded(cube, snapshot.GetCube(x, y, z + 1)),
+            Cube::IsFaceOccluded(cube, snapshot.GetCube(x + 1, y, z)),
+            Cube::IsFaceOccluded(cube, snapshot.GetCube(x, y, z - 1)),
+            Cube::IsFaceOccluded(cube, snapshot.GetCube(x - 1, y, z)),
+            Cube::IsFaceOccluded(cube, snapshot.GetCube(x, y + 1, z)),
+            Cube::IsFaceOccluded(cube, snapshot.GetCube(x, y - 1, z))};
+
+        // Adiciona as faces visíveis diretamente na geometria correspondente
+        Cube::AddVisibleFaces(BlockDatabase::IsOpaque(cube) ? vertices : transparentVertices, cube, glm::vec3(x, y, z), occlusion);
+      }
+    }
+  }
+}
+// Gera a mesh da seção unindo as faces visíveis de cada fatia em retângulos máximos do mesmo bloco
+void ChunkMesher::BuildGreedyMesh(const ChunkSnapshot &snapshot, int section, std::vector<CubeVertex> &vertices, std::vector<CubeVertex> &transparentVertices)
+{
+  const int size = WorldConstants::CHUNK_SIZE;
+  const int padded = size + 2;
+
+  int minY = section * WorldConstants::SECTION_HEIGHT;
+
+  // Copia os blocos da seção com uma camada extra dos vizinhos em volta
+  std::array<uint8_t, padded * padded * padded> blocks;
+
+  for (int y = -1; y <= size; y++)
+    for (int z = -1; z <= size; z++)
+      for (int x = -1; x <= size; x++)
+        blocks[((y + 1) * padded + (z + 1)) * padded + (x + 1)] = static_cast<uint8_t>(snapshot.GetCube(x, minY + y, z));
+
+  auto blockAt = [&blocks, padded](const int position[3])
+  { return blocks[((position[1] + 1) * padded + (position[2] + 1)) * padded + (position[0] + 1)]; };
+
+  std::array<uint8_t, size * size> mask;
+
+  for (int face = 0; face < 6; face++)
+  {
+    int normalAxis = Cube::GetNormalAxis(face);
+    int axisU = Cube::GetTextureAxisU(face);
+    int axisV = Cube::GetTextureAxisV(face);
+
+    int direction = face == CF_FRONT || face == CF_RIGHT || face == CF_TOP ? 1 : -1;
+
+    for (int slice = 0; slice < size; slice++)
+    {
+      // Marca o bloco de cada face visível da fatia
+      for (int v = 0; v < size; v++)
+      {
+        for (int u = 0; u < size; u++)
+        {
+          int position[3];
+          position[normalAxis] = slice;
+          position[axisU] = u;
+          position[axisV] = v;
+
+          int block = blockAt(position);
+
+          position[normalAxis] += direction;
+
+          bool isVisible = block != AIR && Cube::HasFace(block, face) && !Cube::IsFaceOccluded(block, blockAt(position));
+
+          mask[v * size + u] = isVisible ? block : AIR;
+        }
+      }
+
+      // Expande cada face marcada primeiro em u e depois em v enquanto o bloco for o mesmo
+      for (int v = 0; v < size; v++)
+      {
+        for (int u = 0; u < size;)
+        {
+          int block = mask[v * size + u];
+
+          if (block == AIR)
+          {
+            u++;
+            continue;
+          }
+
+          int width = 1;
+
+          while (u + width < size && mask[v * size + u + width] == block)
+            width++;
+
+          int height = 1;
+
+          for (; v + height < size; height++)
+          {
+            bool isRowEqual = true;
+
+            for (int i = 0; i < width && isRowEqual; i++)
+              isRowEqual = mask[(v + height) * size + u + i] == block;
+
+            if (!isRowEqual)
+              break;
+          }
+
+          for (int j = 0; j < height; j++)
+            for (int i = 0; i < width; i++)
+              mask[(v + j) * size + u + i] = AIR;
+
+          glm::vec3 position;
+          position[normalAxis] = static_cast<float>(slice);
+          position[axisU] = static_cast<float>(u);
+          position[axisV] = static_cast<float>(v);
+          position.y += minY;
+
+          glm::vec3 quadSize = glm::vec3(1.0f);
+          quadSize[axisU] = static_cast<float>(width);
+          quadSize[axisV] = static_cast<float>(height);
+
+          Cube::AddFace(BlockDatabase::IsOpaque(block) ? vertices : transparentVertices, block, face, position, quadSize);
+
+          u += width;
+        }
+      }
+    }
+  }
+}
+
+int ChunkMesher::BuildMesh(const ChunkSnapshot &snapshot, int section, MeshingMode mode, std::vector<CubeVertex> &vertices, std::vector<CubeVertex> &transparentVertices)
+{
+  PROFILE_ZONE("ChunkMesher::BuildMesh");
+
+  vertices.clear();
+  transparentVertices.clear();
+
+  if (snapshot.CanSkipSection(section))
+    return 0;
+
+  if (mode == MM_GREEDY)
+    BuildGreedyMesh(snapshot, section, vertices, transparentVertices);
+  else
+    BuildNaiveMesh(snapshot, section, vertices, transparentVertices);
+
+  return ChunkSection::VOLUME;
+}
+
+glm::ivec2 ChunkMesher::GetVerticalBounds(const std::vector<CubeVertex> &vertices, const std::vector<CubeVertex> &transparentVertices)
+{
+  glm::ivec2 bounds = glm::ivec2(WorldConstants::CHUNK_HEIGHT, 0);
+
+  for (const CubeVertex &vertex : vertices)
+    bounds = glm::ivec2(glm::min(bounds.x, Cube::GetVertexY(vertex)), glm::max(bounds.y, Cube::GetVertexY(vertex)));
+
+  for (const CubeVertex &vertex : transparentVertices)
+    bounds = glm::ivec2(glm::min(bounds.x, Cube::GetVertexY(vertex)), glm::max(bounds.y, Cube::GetVertexY(vertex)));
+
+  return bounds;
+}
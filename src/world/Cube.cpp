@@ -11,15 +11,6 @@ static const std::array<uint32_t, 36> ELEMENTS = {
     3, 2, 6, 7, 3, 6  // Bottom face
 };
 
-static const std::array<glm::vec4, 6> NORMALS = {
-    glm::vec4(0.0f, 0.0f, 1.0f, 0.0f),
-    glm::vec4(1.0f, 0.0f, 0.0f, 0.0f),
-    glm::vec4(0.0f, 0.0f, -1.0f, 0.0f),
-    glm::vec4(-1.0f, 0.0f, 0.0f, 0.0f),
-    glm::vec4(0.0f, 1.0f, 0.0f, 0.0f),
-    glm::vec4(0.0f, -1.0f, 0.0f, 0.0f),
-};
-
 static const std::array<glm::vec4, 8> VERTEX_POSITIONS = {
     glm::vec4(0.0f, 1.0f, 1.0f, 1.0f),
     glm::vec4(1.0f, 1.0f, 1.0f, 1.0f),
@@ -30,27 +21,46 @@ static const std::array<glm::vec4, 8> VERTEX_POSITIONS = {
     glm::vec4(0.0f, 0.0f, 0.0f, 1.0f),
     glm::vec4(1.0f, 0.0f, 0.0f, 1.0f)};
 
-// Retorna os vértices visíveis de um cubo
-std::vector<CubeVertex> Cube::GetVisibleVertices(int blockIndex, glm::vec3 position, std::array<glm::vec2, 36> textureCoords, std::array<bool, 6> occludedFaces)
+static const std::array<int, 6> NORMAL_AXES = {2, 0, 2, 0, 1, 1};
+static const std::array<int, 6> TEXTURE_AXES_U = {0, 2, 0, 2, 0, 0};
+static const std::array<int, 6> TEXTURE_AXES_V = {1, 1, 1, 1, 2, 2};
+
+int Cube::GetNormalAxis(int face)
+{
+  return NORMAL_AXES[face];
+}
+
+int Cube::GetTextureAxisU(int face)
+{
+  return TEXTURE_AXES_U[face];
+}
+
+int Cube::GetTextureAxisV(int face)
 {
-  std::vector<CubeVertex> visibleVertices;
+  return TEXTURE_AXES_V[face];
+}
 
-  for (int index = 0; index < 36; index++)
-    if (blockIndex != WATER || (blockIndex == WATER && index / 6 != 5))
-    {
-      if (!occludedFaces[floorf(index / 6)])
-      {
-        CubeVertex vertex = {};
+// Adiciona os vértices visíveis de um cubo
+void Cube::AddVisibleFaces(std::vector<CubeVertex> &vertices, int blockIndex, glm::vec3 position, const std::array<bool, 6> &occludedFaces)
+{
+  for (int face = 0; face < 6; face++)
+    if (HasFace(blockIndex, face) && !occludedFaces[face])
+      AddFace(vertices, blockIndex, face, position, glm::vec3(1.0f));
+}
+
+void Cube::AddFace(std::vector<CubeVertex> &vertices, int blockIndex, int face, glm::vec3 position, glm::vec3 size)
+{
+  int tile = BlockDatabase::GetFaceTile(blockIndex, face);
 
-        glm::vec4 vertexPosition = VERTEX_POSITIONS[ELEMENTS[index]];
+  glm::vec2 textureScale = glm::vec2(size[TEXTURE_AXES_U[face]], size[TEXTURE_AXES_V[face]]);
 
-        vertex.position = glm::vec4(position.x + vertexPosition.x, position.y + vertexPosition.y, position.z + vertexPosition.z, 0.0f),
-        vertex.textureCoords = textureCoords[index];
-        vertex.normal = NORMALS[index / 6];
+  for (int index = face * 6; index < face * 6 + 6; index++)
+  {
+    glm::vec4 vertexPosition = VERTEX_POSITIONS[ELEMENTS[index]];
 
-        visibleVertices.push_back(vertex);
-      }
-    }
+    glm::ivec3 cornerPosition = glm::ivec3(position + glm::vec3(vertexPosition) * size);
+    glm::ivec2 textureCoords = glm::ivec2(BlockTable::FACE_TEXTURE_COORDS[index] * textureScale);
 
-  return visibleVertices;
+    vertices.push_back(PackVertex(cornerPosition, face, tile, textureCoords));
+  }
 }
@@ -2,6 +2,11 @@
 
 #include "world/WorldConstants.hpp"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NOISE_USE_SSE
+#include <emmintrin.h>
+#endif
+
 // Inicializa a noise sem parâmetros
 Noise::Noise()
     : m_Seed(0),
@@ -11,6 +16,7 @@ Noise::Noise()
       m_Roughness(1.0f),
       m_Offset(0.0f)
 {
+  UpdateOctaveTables();
 }
 
 // Inicializa a noise com os parâmetros passados
@@ -22,6 +28,7 @@ Noise::Noise(int seed, int octaves, float amplitude, float smoothness, float rou
       m_Roughness(roughness),
       m_Offset(offset)
 {
+  UpdateOctaveTables();
 }
 
 Noise::~Noise()
@@ -36,6 +43,7 @@ void Noise::SetSeed(int seed)
 void Noise::SetOctaves(int octaves)
 {
   m_Octaves = octaves;
+  UpdateOctaveTables();
 }
 
 void Noise::SetAmplitude(float amplitude)
@@ -46,11 +54,13 @@ void Noise::SetAmplitude(float amplitude)
 void Noise::SetSmoothness(float smoothness)
 {
   m_Smoothness = smoothness;
+  UpdateOctaveTables();
 }
 
 void Noise::SetRoughness(float roughness)
 {
   m_Roughness = roughness;
+  UpdateOctaveTables();
 }
 
 void Noise::SetOffset(float offset)
@@ -58,40 +68,192 @@ void Noise::SetOffset(float offset)
   m_Offset = offset;
 }
 
+// Pré-calcula a frequência e a amplitude de cada oitava
+void Noise::UpdateOctaveTables()
+{
+  m_OctaveFrequencies.resize(m_Octaves);
+  m_OctaveAmplitudes.resize(m_Octaves);
+
+  float frequency = 1.0f;
+  float amplitude = 1.0f;
+  float amplitudeSum = 0.0f;
+
+  for (int i = 0; i < m_Octaves; i++)
+  {
+    m_OctaveFrequencies[i] = frequency / m_Smoothness;
+    m_OctaveAmplitudes[i] = amplitude;
+
+    amplitudeSum += amplitude;
+
+    frequency *= 2.0f;
+    amplitude *= m_Roughness;
+  }
+
+  m_InverseAmplitudeSum = 1.0f / amplitudeSum;
+}
+
 // Calcula a noise em uma posição 2D
-float Noise::GetNoise(glm::vec2 position)
+float Noise::GetNoise(glm::vec2 position) const
 {
   float value = 0;
-  float accumulatedAmplitude = 0;
 
   for (int i = 0; i < m_Octaves; i++)
   {
-    float frequency = glm::pow(2.0f, i);
-    float amplitude = glm::pow(m_Roughness, i);
-
     // Calcula as posições com base na frequência e suavização
-    float x = position.x * frequency / m_Smoothness;
-    float y = position.y * frequency / m_Smoothness;
+    float x = position.x * m_OctaveFrequencies[i];
+    float y = position.y * m_OctaveFrequencies[i];
 
     // Gera a noise simplex para a posição
-    float noise = glm::simplex(glm::vec3(m_Seed + x, m_Seed + y, m_Seed));
+    float noise = glm::simplex(glm::vec2(m_Seed + x, m_Seed + y));
 
     // Calcula o valor da noise com a amplitude
     noise = (noise + 1.0f) / 2.0f;
-    value += noise * amplitude;
-
-    accumulatedAmplitude += amplitude;
+    value += noise * m_OctaveAmplitudes[i];
   }
 
-  return value / accumulatedAmplitude;
+  return value * m_InverseAmplitudeSum;
 }
 
 // Calcula a noise em uma posição do mundo
-float Noise::GetNoise(glm::vec2 blockPosition, glm::vec2 chunkPosition)
+float Noise::GetNoise(glm::vec2 blockPosition, glm::vec2 chunkPosition) const
 {
   glm::vec2 computedChunkPosition = glm::vec2(
       chunkPosition.x * WorldConstants::CHUNK_SIZE,
       chunkPosition.y * WorldConstants::CHUNK_SIZE);
 
   return GetNoise(blockPosition + computedChunkPosition);
-}
\ No newline at end of file
+}
+
+#ifdef NOISE_USE_SSE
+
+// floor com SSE2, que não tem _mm_floor_ps
+static inline __m128 FloorSSE(__m128 x)
+{
+  __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+  __m128 correction = _mm_and_ps(_mm_cmpgt_ps(truncated, x), _mm_set1_ps(1.0f));
+
+  return _mm_sub_ps(truncated, correction);
+}
+
+static inline __m128 Mod289SSE(__m128 x)
+{
+  return _mm_sub_ps(x, _mm_mul_ps(FloorSSE(_mm_mul_ps(x, _mm_set1_ps(1.0f / 289.0f))), _mm_set1_ps(289.0f)));
+}
+
+static inline __m128 PermuteSSE(__m128 x)
+{
+  return Mod289SSE(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(34.0f)), _mm_set1_ps(1.0f)), x));
+}
+
+// Simplex 2D em 4 posições de uma vez
+// Segue operação por operação o glm::simplex de 2 dimensões, para gerar os mesmos valores
+static __m128 SimplexSSE(__m128 vx, __m128 vy)
+{
+  const __m128 c0 = _mm_set1_ps(0.211324865405187f);
+  const __m128 c1 = _mm_set1_ps(0.366025403784439f);
+  const __m128 c2 = _mm_set1_ps(-0.577350269189626f);
+  const __m128 c3 = _mm_set1_ps(0.024390243902439f);
+
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 ring = _mm_set1_ps(289.0f);
+  const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+
+  // Primeiro vértice
+  __m128 skew = _mm_add_ps(_mm_mul_ps(vx, c1), _mm_mul_ps(vy, c1));
+  __m128 ix = FloorSSE(_mm_add_ps(vx, skew));
+  __m128 iy = FloorSSE(_mm_add_ps(vy, skew));
+
+  __m128 unskew = _mm_add_ps(_mm_mul_ps(ix, c0), _mm_mul_ps(iy, c0));
+  __m128 x0x = _mm_add_ps(_mm_sub_ps(vx, ix), unskew);
+  __m128 x0y = _mm_add_ps(_mm_sub_ps(vy, iy), unskew);
+
+  // Outros vértices
+  __m128 i1x = _mm_and_ps(_mm_cmpgt_ps(x0x, x0y), one);
+  __m128 i1y = _mm_sub_ps(one, i1x);
+
+  __m128 x1x = _mm_sub_ps(_mm_add_ps(x0x, c0), i1x);
+  __m128 x1y = _mm_sub_ps(_mm_add_ps(x0y, c0), i1y);
+  __m128 x2x = _mm_add_ps(x0x, c2);
+  __m128 x2y = _mm_add_ps(x0y, c2);
+
+  // Permutações
+  ix = _mm_sub_ps(ix, _mm_mul_ps(ring, FloorSSE(_mm_div_ps(ix, ring))));
+  iy = _mm_sub_ps(iy, _mm_mul_ps(ring, FloorSSE(_mm_div_ps(iy, ring))));
+
+  __m128 p0 = PermuteSSE(_mm_add_ps(_mm_add_ps(PermuteSSE(iy), ix), zero));
+  __m128 p1 = PermuteSSE(_mm_add_ps(_mm_add_ps(PermuteSSE(_mm_add_ps(iy, i1y)), ix), i1x));
+  __m128 p2 = PermuteSSE(_mm_add_ps(_mm_add_ps(PermuteSSE(_mm_add_ps(iy, one)), ix), one));
+
+  __m128 m0 = _mm_max_ps(_mm_sub_ps(half, _mm_add_ps(_mm_mul_ps(x0x, x0x), _mm_mul_ps(x0y, x0y))), zero);
+  __m128 m1 = _mm_max_ps(_mm_sub_ps(half, _mm_add_ps(_mm_mul_ps(x1x, x1x), _mm_mul_ps(x1y, x1y))), zero);
+  __m128 m2 = _mm_max_ps(_mm_sub_ps(half, _mm_add_ps(_mm_mul_ps(x2x, x2x), _mm_mul_ps(x2y, x2y))), zero);
+
+  m0 = _mm_mul_ps(m0, m0);
+  m1 = _mm_mul_ps(m1, m1);
+  m2 = _mm_mul_ps(m2, m2);
+
+  m0 = _mm_mul_ps(m0, m0);
+  m1 = _mm_mul_ps(m1, m1);
+  m2 = _mm_mul_ps(m2, m2);
+
+  // Gradientes e contribuição de cada vértice
+  __m128 p[3] = {p0, p1, p2};
+  __m128 m[3] = {m0, m1, m2};
+  __m128 dx[3] = {x0x, x1x, x2x};
+  __m128 dy[3] = {x0y, x1y, x2y};
+  __m128 g[3];
+
+  for (int i = 0; i < 3; i++)
+  {
+    __m128 scaled = _mm_mul_ps(p[i], c3);
+    __m128 x = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(2.0f), _mm_sub_ps(scaled, FloorSSE(scaled))), one);
+    __m128 h = _mm_sub_ps(_mm_and_ps(x, absMask), half);
+    __m128 a0 = _mm_sub_ps(x, FloorSSE(_mm_add_ps(x, half)));
+
+    m[i] = _mm_mul_ps(m[i], _mm_sub_ps(_mm_set1_ps(1.79284291400159f), _mm_mul_ps(_mm_set1_ps(0.85373472095314f), _mm_add_ps(_mm_mul_ps(a0, a0), _mm_mul_ps(h, h)))));
+    g[i] = _mm_add_ps(_mm_mul_ps(a0, dx[i]), _mm_mul_ps(h, dy[i]));
+  }
+
+  __m128 sum = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[0], g[0]), _mm_mul_ps(m[1], g[1])), _mm_mul_ps(m[2], g[2]));
+
+  return _mm_mul_ps(_mm_set1_ps(130.0f), sum);
+}
+
+#endif
+
+void Noise::GetNoiseGrid(glm::vec2 origin, int width, int height, float *out) const
+{
+  for (int z = 0; z < height; z++)
+  {
+    int x = 0;
+
+#ifdef NOISE_USE_SSE
+    __m128 py = _mm_set1_ps(origin.y + static_cast<float>(z));
+    __m128 seed = _mm_set1_ps(static_cast<float>(m_Seed));
+
+    for (; x + 4 <= width; x += 4)
+    {
+      __m128 px = _mm_add_ps(_mm_set1_ps(origin.x), _mm_setr_ps(static_cast<float>(x), static_cast<float>(x + 1), static_cast<float>(x + 2), static_cast<float>(x + 3)));
+      __m128 value = _mm_setzero_ps();
+
+      for (int i = 0; i < m_Octaves; i++)
+      {
+        __m128 frequency = _mm_set1_ps(m_OctaveFrequencies[i]);
+
+        __m128 noise = SimplexSSE(_mm_add_ps(seed, _mm_mul_ps(px, frequency)), _mm_add_ps(seed, _mm_mul_ps(py, frequency)));
+
+        noise = _mm_div_ps(_mm_add_ps(noise, _mm_set1_ps(1.0f)), _mm_set1_ps(2.0f));
+        value = _mm_add_ps(value, _mm_mul_ps(noise, _mm_set1_ps(m_OctaveAmplitudes[i])));
+      }
+
+      _mm_storeu_ps(out + x + z * width, _mm_mul_ps(value, _mm_set1_ps(m_InverseAmplitudeSum)));
+    }
+#endif
+
+    // Posições restantes, ou todas quando não há SSE
+    for (; x < width; x++)
+      out[x + z * width] = GetNoise(origin + glm::vec2(x, z));
+  }
+}
@@ -93,7 +93,7 @@ void Object::ComputeNormals()
 void Object::BuildVertices()
 {
   glGenVertexArrays(1, &m_VertexArrayObjectId);
-  glBindVertexArray(m_VertexArrayObjectId);
+  GLState::BindVertexArray(m_VertexArrayObjectId);
 
   std::vector<GLuint> indices;
   std::vector<float> model_coefficients;
@@ -171,48 +171,47 @@ void Object::BuildVertices()
 
   GLuint VBO_model_coefficients_id;
   glGenBuffers(1, &VBO_model_coefficients_id);
-  glBindBuffer(GL_ARRAY_BUFFER, VBO_model_coefficients_id);
+  GLState::BindBuffer(GL_ARRAY_BUFFER, VBO_model_coefficients_id);
   glBufferData(GL_ARRAY_BUFFER, model_coefficients.size() * sizeof(float), NULL, GL_STATIC_DRAW);
   glBufferSubData(GL_ARRAY_BUFFER, 0, model_coefficients.size() * sizeof(float), model_coefficients.data());
   GLuint location = 0;            // "(location = 0)" em "shader_vertex.glsl"
   GLint number_of_dimensions = 4; // vec4 em "shader_vertex.glsl"
   glVertexAttribPointer(location, number_of_dimensions, GL_FLOAT, GL_FALSE, 0, 0);
   glEnableVertexAttribArray(location);
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
 
   if (!normal_coefficients.empty())
   {
     GLuint VBO_normal_coefficients_id;
     glGenBuffers(1, &VBO_normal_coefficients_id);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO_normal_coefficients_id);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, VBO_normal_coefficients_id);
     glBufferData(GL_ARRAY_BUFFER, normal_coefficients.size() * sizeof(float), NULL, GL_STATIC_DRAW);
     glBufferSubData(GL_ARRAY_BUFFER, 0, normal_coefficients.size() * sizeof(float), normal_coefficients.data());
     location = 1;             // "(location = 1)" em "shader_vertex.glsl"
     number_of_dimensions = 4; // vec4 em "shader_vertex.glsl"
     glVertexAttribPointer(location, number_of_dimensions, GL_FLOAT, GL_FALSE, 0, 0);
     glEnableVertexAttribArray(location);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
   }
 
   if (!texture_coefficients.empty())
   {
     GLuint VBO_texture_coefficients_id;
     glGenBuffers(1, &VBO_texture_coefficients_id);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO_texture_coefficients_id);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, VBO_texture_coefficients_id);
     glBufferData(GL_ARRAY_BUFFER, texture_coefficients.size() * sizeof(float), NULL, GL_STATIC_DRAW);
     glBufferSubData(GL_ARRAY_BUFFER, 0, texture_coefficients.size() * sizeof(float), texture_coefficients.data());
     location = 2;             // "(location = 1)" em "shader_vertex.glsl"
     number_of_dimensions = 2; // vec2 em "shader_vertex.glsl"
     glVertexAttribPointer(location, number_of_dimensions, GL_FLOAT, GL_FALSE, 0, 0);
     glEnableVertexAttribArray(location);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
   }
 
-  GLuint indices_id;
-  glGenBuffers(1, &indices_id);
+  glGenBuffers(1, &m_IndexBufferId);
 
   // "Ligamos" o buffer. Note que o tipo agora é GL_ELEMENT_ARRAY_BUFFER.
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indices_id);
+  GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferId);
   glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), NULL, GL_STATIC_DRAW);
   glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indices.size() * sizeof(GLuint), indices.data());
   // glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); // XXX Errado!
@@ -220,30 +219,33 @@ void Object::BuildVertices()
 
   // "Desligamos" o VAO, evitando assim que operações posteriores venham a
   // alterar o mesmo. Isso evita bugs.
-  glBindVertexArray(0);
+  GLState::BindVertexArray(0);
 }
 
-// Desenha o modelo
-void Object::Draw(Shader *shader, glm::mat4 view, glm::mat4 projection, bool isGouraud)
+// Envia o modelo para a fila
+void Object::Draw(RenderQueue &queue, Shader *shader, glm::vec4 cameraPosition, bool isGouraud)
 {
-  shader->Bind();
-
-  shader->SetUniformMat4f("uView", view);
-  shader->SetUniformMat4f("uProjection", projection);
+  if (shader != m_UniformShader)
+  {
+    m_UniformShader = shader;
+    m_ModelUniform = shader->GetUniform<glm::mat4>("uModel");
+    m_IsGouraudUniform = shader->GetUniform<int>("uIsGouraud");
+  }
 
-  glm::mat4 model = Matrices::MatrixTranslate(m_ObjectX, 30.0f, m_ObjectZ);
+  glm::vec4 position = glm::vec4(m_ObjectX, 30.0f, m_ObjectZ, 1.0f);
 
-  shader->SetUniformMat4f("uModel", model);
+  DrawPacket packet;
 
-  shader->SetUniform1i("uIsGouraud", isGouraud ? 1 : 0);
+  packet.program = shader->GetRendererId();
+  packet.vertexArray = m_VertexArrayObjectId;
+  packet.indexBuffer = m_IndexBufferId;
 
-  glBindVertexArray(m_VertexArrayObjectId);
+  packet.AddUniform(m_ModelUniform, Matrices::MatrixTranslate(position.x, position.y, position.z));
+  packet.AddUniform(m_IsGouraudUniform, isGouraud ? 1 : 0);
 
-  glDrawElements(
-      GL_TRIANGLES,
-      m_IndexCount,
-      GL_UNSIGNED_INT,
-      (void *)(m_FirstIndex * sizeof(GLuint)));
+  packet.command = DC_ELEMENTS;
+  packet.elementCount = m_IndexCount;
+  packet.elementOffset = m_FirstIndex * sizeof(GLuint);
 
-  glBindVertexArray(0);
-}
\ No newline at end of file
+  queue.Submit(DP_OPAQUE, glm::length(position - cameraPosition), packet);
+}
@@ -0,0 +1,231 @@
+#include <array>
+#include <cstdlib>
+
+#include "world/SectionVisibility.hpp"
+
+#include "world/BlockDatabase.hpp"
+
+namespace
+{
+  const int SIZE = WorldConstants::CHUNK_SIZE;
+  const int HEIGHT = WorldConstants::SECTION_HEIGHT;
+
+  // Deslocamento de uma seção para a vizinha através de cada face, na ordem de SectionFace
+  const glm::ivec3 FACE_OFFSETS[6] = {
+      glm::ivec3(-1, 0, 0),
+      glm::ivec3(1, 0, 0),
+      glm::ivec3(0, -1, 0),
+      glm::ivec3(0, 1, 0),
+      glm::ivec3(0, 0, -1),
+      glm::ivec3(0, 0, 1),
+  };
+
+  // Faces da seção tocadas por um bloco
+  int GetBlockFaces(int x, int y, int z)
+  {
+    int faces = 0;
+
+    if (x == 0)
+      faces |= 1 << SF_WEST;
+    if (x == SIZE - 1)
+      faces |= 1 << SF_EAST;
+    if (y == 0)
+      faces |= 1 << SF_DOWN;
+    if (y == HEIGHT - 1)
+      faces |= 1 << SF_UP;
+    if (z == 0)
+      faces |= 1 << SF_NORTH;
+    if (z == SIZE - 1)
+      faces |= 1 << SF_SOUTH;
+
+    return faces;
+  }
+}
+
+uint16_t SectionVisibility::ConnectFaces(int faces)
+{
+  uint16_t connectivity = 0;
+
+  for (int a = 0; a < 6; a++)
+    for (int b = a + 1; b < 6; b++)
+      if ((faces & (1 << a)) && (faces & (1 << b)))
+        connectivity |= 1 << GetPairBit(a, b);
+
+  return connectivity;
+}
+
+// Separa os blocos não opacos em regiões ligadas pelas faces e une as faces da seção tocadas por cada região
+uint16_t SectionVisibility::ComputeConnectivity(const ChunkSection &section)
+{
+  if (section.IsEmpty())
+    return ALL_CONNECTED;
+
+  if (section.IsFullyOpaque())
+    return NONE_CONNECTED;
+
+  const BlockStorage &storage = section.GetStorage();
+
+  // Blocos opacos e já visitados são marcados da mesma forma, pois nenhum dos dois entra em outra região
+  std::array<bool, ChunkSection::VOLUME> isClosed;
+
+  for (int i = 0; i < ChunkSection::VOLUME; i++)
+    isClosed[i] = BlockDatabase::IsOpaque(storage.Get(i));
+
+  std::array<uint16_t, ChunkSection::VOLUME> stack;
+
+  uint16_t connectivity = NONE_CONNECTED;
+
+  for (int i = 0; i < ChunkSection::VOLUME && connectivity != ALL_CONNECTED; i++)
+  {
+    int x = i % SIZE;
+    int z = (i / SIZE) % SIZE;
+    int y = i / (SIZE * SIZE);
+
+    // Regiões que não tocam a borda não ligam nenhuma face, então só a borda inicia o preenchimento
+    if (isClosed[i] || GetBlockFaces(x, y, z) == 0)
+      continue;
+
+    int faces = 0;
+    int stackSize = 0;
+
+    stack[stackSize++] = static_cast<uint16_t>(i);
+    isClosed[i] = true;
+
+    while (stackSize > 0)
+    {
+      int index = stack[--stackSize];
+
+      int bx = index % SIZE;
+      int bz = (index / SIZE) % SIZE;
+      int by = index / (SIZE * SIZE);
+
+      faces |= GetBlockFaces(bx, by, bz);
+
+      for (const glm::ivec3 &offset : FACE_OFFSETS)
+      {
+        int nx = bx + offset.x;
+        int ny = by + offset.y;
+        int nz = bz + offset.z;
+
+        if (nx < 0 || nx >= SIZE || ny < 0 || ny >= HEIGHT || nz < 0 || nz >= SIZE)
+          continue;
+
+        int neighbor = ChunkSection::GetBlockIndex(nx, ny, nz);
+
+        if (isClosed[neighbor])
+          continue;
+
+        isClosed[neighbor] = true;
+        stack[stackSize++] = static_cast<uint16_t>(neighbor);
+      }
+    }
+
+    connectivity |= ConnectFaces(faces);
+  }
+
+  return connectivity;
+}
+
+void SectionVisibility::Traverse(glm::ivec3 start, int radius, const ConnectivityCallback &getConnectivity, const VisitCallback &visit)
+{
+  const int NO_FACE = 6;
+  const uint8_t NOT_REACHED = 0xFF;
+
+  enum SectionState
+  {
+    SS_UNKNOWN,
+    SS_OPEN,    // Visitada e atravessável
+    SS_BLOCKED, // Fora do mundo carregado ou recusada pela visita
+  };
+
+  // Seção a atravessar, com a face por onde o caminho entrou e as direções já percorridas (um bit por face)
+  struct Step
+  {
+    glm::ivec3 position;
+    int entryFace;
+    uint8_t directions;
+  };
+
+  int width = 2 * radius + 1;
+  int cellCount = width * width * WorldConstants::SECTIONS_PER_CHUNK;
+
+  // Buffers reaproveitados entre frames
+  static thread_local std::vector<uint8_t> states;
+  static thread_local std::vector<uint16_t> connectivities;
+  static thread_local std::vector<uint8_t> reachedDirections;
+  static thread_local std::vector<Step> queue;
+
+  states.assign(cellCount, SS_UNKNOWN);
+  connectivities.resize(cellCount);
+  reachedDirections.assign(cellCount * 6, NOT_REACHED);
+  queue.clear();
+
+  auto getCell = [&](glm::ivec3 position)
+  {
+    return ((position.x - start.x + radius) * width + position.z - start.z + radius) * WorldConstants::SECTIONS_PER_CHUNK + position.y;
+  };
+
+  int startConnectivity = getConnectivity(start);
+
+  if (startConnectivity < 0 || !visit(start))
+    return;
+
+  states[getCell(start)] = SS_OPEN;
+  connectivities[getCell(start)] = static_cast<uint16_t>(startConnectivity);
+
+  // A seção da câmera é atravessada em qualquer direção, pois a câmera está dentro dela
+  queue.push_back({start, NO_FACE, 0});
+
+  for (size_t head = 0; head < queue.size(); head++)
+  {
+    Step step = queue[head];
+
+    uint16_t connectivity = connectivities[getCell(step.position)];
+
+    for (int face = 0; face < 6; face++)
+    {
+      int oppositeFace = face ^ 1;
+
+      if (step.directions & (1 << oppositeFace))
+        continue;
+
+      if (step.entryFace != NO_FACE && !AreFacesConnected(connectivity, step.entryFace, face))
+        continue;
+
+      glm::ivec3 next = step.position + FACE_OFFSETS[face];
+
+      if (next.y < 0 || next.y >= WorldConstants::SECTIONS_PER_CHUNK || abs(next.x - start.x) > radius || abs(next.z - start.z) > radius)
+        continue;
+
+      int cell = getCell(next);
+
+      if (states[cell] == SS_UNKNOWN)
+      {
+        int nextConnectivity = getConnectivity(next);
+
+        if (nextConnectivity >= 0 && visit(next))
+        {
+          states[cell] = SS_OPEN;
+          connectivities[cell] = static_cast<uint16_t>(nextConnectivity);
+        }
+        else
+          states[cell] = SS_BLOCKED;
+      }
+
+      if (states[cell] == SS_BLOCKED)
+        continue;
+
+      // Uma seção é atravessada de novo pela mesma face só se o novo caminho libera mais direções;
+      // guardar a interseção das direções mantém o percurso conservador em relação a todos os caminhos
+      uint8_t directions = step.directions | (1 << face);
+      uint8_t &reached = reachedDirections[cell * 6 + oppositeFace];
+
+      if (reached != NOT_REACHED && (reached & directions) == reached)
+        continue;
+
+      reached = reached == NOT_REACHED ? directions : reached & directions;
+
+      queue.push_back({next, oppositeFace, reached});
+    }
+  }
+}
@@ -1,9 +1,20 @@
+#include <algorithm>
+
 #include "world/TerrainGeneration.hpp"
 
+#include "core/Random.hpp"
+
 #include "world/BlockDatabase.hpp"
 
 const int SEED = 8500;
 
+// Streams do gerador aleatório para cada decisão da geração
+const uint32_t DIRT_DEPTH_STREAM = 1;
+const uint32_t ORE_STREAM = 2;
+const uint32_t ORE_TYPE_STREAM = 3;
+
+const int ORES[5] = {IRON_ORE, COAL_ORE, DIAMOND_ORE, REDSTONE_ORE, GOLD_ORE};
+
 // Inicializa as noises de base e de detalhes
 Noise TerrainGeneration::baseNoise = Noise(SEED, 6, 105.0f, 205.0f, 0.58f, 18);
 Noise TerrainGeneration::accentNoise = Noise(SEED, 4, 20.0f, 200.0f, 0.45f, 0);
@@ -16,6 +27,12 @@ int TerrainGeneration::GetHeight(glm::vec2 blockPosition, glm::vec2 chunkPositio
 
   auto island = GetIslandHeight(blockPosition, chunkPosition, 2.0f) * 1.25;
 
+  return CombineHeight(noise, noise2, island);
+}
+
+// Combina as noises e a altura de ilha em uma altura do terreno
+int TerrainGeneration::CombineHeight(float noise, float noise2, double island)
+{
   // Combina as duas noises para gerar um terreno mais interessante
   float result = noise * noise2;
 
@@ -29,13 +46,37 @@ int TerrainGeneration::GetHeight(glm::vec2 blockPosition, glm::vec2 chunkPositio
   return glm::max(height, WorldConstants::MIN_HEIGHT);
 }
 
-// Computa qual bloco deve ser gerado na altura
-int TerrainGeneration::GetBlockAtHeight(int y, int height)
+// Calcula as alturas de todas as colunas do chunk avaliando as noises em grade
+void TerrainGeneration::GetHeightMap(int chunkX, int chunkZ, int *heights)
 {
-  int ores[6] = {IRON_ORE, COAL_ORE, DIAMOND_ORE, REDSTONE_ORE, GOLD_ORE, LAPIS_ORE};
+  const int size = WorldConstants::CHUNK_SIZE;
+
+  float baseValues[size * size];
+  float accentValues[size * size];
 
-  // Gera um valor aleatório para a altura de terra até ter pedra
-  int heightToStone = rand() % 3 + 2;
+  glm::vec2 origin = glm::vec2(chunkX * size, chunkZ * size);
+
+  baseNoise.GetNoiseGrid(origin, size, size, baseValues);
+  accentNoise.GetNoiseGrid(origin, size, size, accentValues);
+
+  for (int z = 0; z < size; z++)
+  {
+    for (int x = 0; x < size; x++)
+    {
+      int column = x + z * size;
+
+      auto island = GetIslandHeight(glm::vec2(x, z), glm::vec2(chunkX, chunkZ), 2.0f) * 1.25;
+
+      heights[column] = CombineHeight(baseValues[column], accentValues[column], island);
+    }
+  }
+}
+
+// Computa qual bloco deve ser gerado na altura
+int TerrainGeneration::GetBlockAtHeight(int x, int y, int z, int height)
+{
+  // Gera um valor aleatório para a altura de terra até ter pedra, fixo para cada coluna
+  int heightToStone = Random::Range(SEED, DIRT_DEPTH_STREAM, x, 0, z, 3) + 2;
 
   // Se y é menor ou igual à altura
   if (y <= height)
@@ -56,19 +97,8 @@ int TerrainGeneration::GetBlockAtHeight(int y, int height)
       // Se está embaixo da camada de terra
       else if (y <= height - heightToStone)
       {
-        int willHaveOre = rand() % 20;
-
-        // Testa aleatoriamente se vai ter um bloco de minério
-        if (willHaveOre == 5)
-        {
-          int oreIndex = rand() % 5;
-          return ores[oreIndex];
-        }
-        else
-        {
-          // Senão retorna pedra
-          return STONE;
-        }
+        // Testa aleatoriamente se vai ter um bloco de minério, senão retorna pedra
+        return GetOreAt(x, y, z);
       }
       else
       {
@@ -90,4 +120,62 @@ int TerrainGeneration::GetBlockAtHeight(int y, int height)
       return AIR;
     }
   }
+}
+
+int TerrainGeneration::GetOreAt(int x, int y, int z)
+{
+  int willHaveOre = Random::Range(SEED, ORE_STREAM, x, y, z, 20);
+
+  if (willHaveOre != 5)
+    return STONE;
+
+  return ORES[Random::Range(SEED, ORE_TYPE_STREAM, x, y, z, 5)];
+}
+
+ColumnSpans TerrainGeneration::GetColumnSpans(int x, int z, int height)
+{
+  int heightToStone = Random::Range(SEED, DIRT_DEPTH_STREAM, x, 0, z, 3) + 2;
+
+  ColumnSpans spans;
+
+  spans.stoneTop = height - heightToStone;
+  spans.dirtTop = height - 1;
+  spans.surface = height;
+  spans.surfaceBlock = height > WorldConstants::WATER_LEVEL + 3 ? GRASS : SAND;
+  spans.waterTop = WorldConstants::WATER_LEVEL;
+
+  return spans;
+}
+
+void TerrainGeneration::FillColumn(int x, int z, int height, uint8_t *column)
+{
+  ColumnSpans spans = GetColumnSpans(x, z, height);
+
+  int dirtStart = std::max(spans.stoneTop + 1, 1);
+
+  // Escreve cada faixa de uma vez
+  std::fill(column, column + WorldConstants::CHUNK_HEIGHT, static_cast<uint8_t>(AIR));
+
+  if (spans.stoneTop >= 1)
+    std::fill(column + 1, column + spans.stoneTop + 1, static_cast<uint8_t>(STONE));
+
+  if (spans.dirtTop >= dirtStart)
+    std::fill(column + dirtStart, column + spans.dirtTop + 1, static_cast<uint8_t>(DIRT));
+
+  if (spans.waterTop > spans.surface)
+    std::fill(column + spans.surface + 1, column + std::min(spans.waterTop, WorldConstants::CHUNK_HEIGHT - 1) + 1, static_cast<uint8_t>(WATER));
+
+  column[0] = BEDROCK;
+  column[spans.surface] = static_cast<uint8_t>(spans.surfaceBlock);
+
+  // Passada esparsa de minérios: o prefixo do hash é calculado uma vez por coluna
+  // e o tipo do minério só é sorteado onde há minério
+  uint32_t orePrefix = Random::HashPrefix(SEED, ORE_STREAM, x);
+  uint32_t oreTypePrefix = Random::HashPrefix(SEED, ORE_TYPE_STREAM, x);
+
+  for (int y = 1; y <= spans.stoneTop; y++)
+  {
+    if (Random::HashFromPrefix(orePrefix, y, z) % 20 == 5)
+      column[y] = static_cast<uint8_t>(ORES[Random::HashFromPrefix(oreTypePrefix, y, z) % 5]);
+  }
 }
\ No newline at end of file
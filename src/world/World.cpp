@@ -1,143 +1,770 @@
 #include <algorithm>
+#include <climits>
 
 #include "world/World.hpp"
 
-#include "core/Matrices.hpp"
+#include "core/Profiler.hpp"
 
-// Inicializa o mundo
-World::World(Shader *shader)
+// Inicializa o mundo carregando os chunks ao redor da posição inicial
+World::World(Shader *shader, glm::vec4 position, int renderDistance)
     : m_Shader(shader),
-      m_TextureAtlas(new Texture("extras/textures/atlas.png", true))
+      m_TextureAtlas(new Texture("extras/textures/atlas.png", true)),
+      m_VertexArena(CreateVertexArena()),
+      m_ThreadPool(new ThreadPool()),
+      m_LastMeshVersion(0),
+      m_CullingStats(),
+      m_IsOcclusionCullingEnabled(true),
+      m_IsCaveCullingEnabled(true),
+      m_EditCount(0),
+      m_EditVoxelsVisited(0),
+      m_RenderDistance(renderDistance),
+      m_MeshingMode(MM_GREEDY)
 {
-  // Adiciona os chunks na lista de atualização
-  for (int x = 0; x < WorldConstants::CHUNKS_PER_AXIS; x++)
+  int blockX;
+  int blockZ;
+
+  SplitCoordinate((int)floorf(position.x), &m_CenterChunk.x, &blockX);
+  SplitCoordinate((int)floorf(position.z), &m_CenterChunk.y, &blockZ);
+
+  // Uniforms que não mudam entre frames são definidos uma única vez no programa
+  m_Shader->Bind();
+
+  m_Shader->SetUniform1i("uTexture", 0);
+  m_Shader->SetUniform1i("uPageOrigins", 1);
+  m_Shader->SetUniform1i("uPageVertices", VertexArena::PAGE_VERTICES);
+
+  glm::vec2 tileSize = BlockDatabase::GetTileSize();
+  m_Shader->SetUniform2f("uTileSize", tileSize.x, tileSize.y);
+
+  m_IsOpaqueUniform = m_Shader->GetUniform<int>("uIsOpaque");
+
+  m_DrawOrderChunk = m_CenterChunk;
+  m_DrawOrderSection = -1;
+
+  UpdateDrawOrder(glm::vec3(position));
+
+  UpdateLoadQueue();
+
+  // Gera todos os chunks iniciais de uma vez
+  GenerateChunks(m_ChunksToLoad);
+
+  m_ChunksToLoad.clear();
+
+  // Constrói as meshes dos chunks iniciais antes do primeiro frame
+  UpdateMeshes();
+  FinishMeshes();
+}
+
+World::~World()
+{
+  // Espera as gerações em andamento antes de liberar os chunks e as meshes
+  delete m_ThreadPool;
+
+  for (Chunk *chunk : m_GeneratedChunks)
+    delete chunk;
+
+  for (auto &chunk : m_Chunks)
+    delete chunk.second;
+
+  delete m_VertexArena;
+}
+
+VertexArena *World::CreateVertexArena()
+{
+  // Posição e textura empacotadas de CubeVertex, lidas como uint no shader
+  VertexBufferLayout layout;
+
+  layout.Push(LayoutType::LT_UINT, 1);
+  layout.Push(LayoutType::LT_UINT, 1);
+
+  return new VertexArena(layout, sizeof(CubeVertex), WorldConstants::INITIAL_ARENA_PAGES);
+}
+
+// Gera os chunks em todas as threads e espera o término
+// A geração é uma função pura da posição, então o resultado é igual ao da geração sequencial
+void World::GenerateChunks(const std::vector<glm::ivec2> &positions)
+{
+  std::vector<Chunk *> chunks(positions.size(), nullptr);
+
+  for (size_t i = 0; i < positions.size(); i++)
+  {
+    glm::ivec2 position = positions[i];
+    Chunk **chunk = &chunks[i];
+
+    m_ThreadPool->Submit([position, chunk]()
+                         { *chunk = new Chunk(position.x, position.y); });
+  }
+
+  m_ThreadPool->Wait();
+
+  for (Chunk *chunk : chunks)
+    AddChunk(chunk);
+}
+
+// Agenda a geração de um chunk em segundo plano
+void World::RequestChunk(glm::ivec2 position)
+{
+  m_PendingChunks.insert(GetChunkKey(position.x, position.y));
+
+  m_ThreadPool->Submit([this, position]()
+                       {
+                         Chunk *chunk = new Chunk(position.x, position.y);
+
+                         std::lock_guard<std::mutex> lock(m_GeneratedChunksMutex);
+                         m_GeneratedChunks.push_back(chunk); });
+}
+
+// Adiciona um chunk gerado ao mundo, restaurando seus blocos se ele foi modificado,
+// e agenda a atualização da mesh dele e dos vizinhos
+void World::AddChunk(Chunk *chunk)
+{
+  glm::ivec2 position = glm::ivec2(chunk->GetChunkX(), chunk->GetChunkZ());
+
+  int64_t key = GetChunkKey(position.x, position.y);
+
+  if (m_Chunks.find(key) != m_Chunks.end())
+  {
+    delete chunk;
+    return;
+  }
+
+  auto saved = m_SavedChunks.find(key);
+
+  if (saved != m_SavedChunks.end())
+  {
+    chunk->Deserialize(saved->second);
+    chunk->MarkModified();
+
+    m_SavedChunks.erase(saved);
+  }
+
+  m_Chunks[key] = chunk;
+
+  m_DrawOrder.insert(std::upper_bound(m_DrawOrder.begin(), m_DrawOrder.end(), chunk, [this](const Chunk *a, const Chunk *b)
+                                      { return IsDrawnBefore(a, b); }),
+                     chunk);
+
+  MarkSectionsDirty(position, Chunk::ALL_SECTIONS, false);
+  MarkSectionsDirty(position + glm::ivec2(-1, 0), Chunk::ALL_SECTIONS, false);
+  MarkSectionsDirty(position + glm::ivec2(1, 0), Chunk::ALL_SECTIONS, false);
+  MarkSectionsDirty(position + glm::ivec2(0, -1), Chunk::ALL_SECTIONS, false);
+  MarkSectionsDirty(position + glm::ivec2(0, 1), Chunk::ALL_SECTIONS, false);
+}
+
+// Descarrega um chunk, guardando seus blocos se ele foi modificado
+void World::UnloadChunk(int64_t key)
+{
+  auto it = m_Chunks.find(key);
+
+  if (it == m_Chunks.end())
+    return;
+
+  Chunk *chunk = it->second;
+
+  if (chunk->IsModified())
+  {
+    std::vector<uint8_t> &data = m_SavedChunks[key];
+
+    data.clear();
+    chunk->Serialize(data);
+  }
+
+  m_DrawOrder.erase(std::find(m_DrawOrder.begin(), m_DrawOrder.end(), chunk));
+
+  delete chunk;
+
+  m_Chunks.erase(it);
+}
+
+// Descarrega os chunks fora do raio e recalcula a fila de chunks a carregar, do mais próximo ao mais distante
+void World::UpdateLoadQueue()
+{
+  std::vector<int64_t> chunksToUnload;
+
+  for (auto &chunk : m_Chunks)
   {
-    for (int z = 0; z < WorldConstants::CHUNKS_PER_AXIS; z++)
+    if (!IsInUnloadDistance(chunk.second->GetChunkX(), chunk.second->GetChunkZ()))
+      chunksToUnload.push_back(chunk.first);
+  }
+
+  for (int64_t key : chunksToUnload)
+    UnloadChunk(key);
+
+  m_ChunksToLoad.clear();
+
+  for (int dx = -m_RenderDistance; dx <= m_RenderDistance; dx++)
+  {
+    for (int dz = -m_RenderDistance; dz <= m_RenderDistance; dz++)
     {
-      m_Chunks[x][z] = new Chunk(x, z);
-      m_ChunksToUpdate.push_back(glm::vec2(x, z));
+      if (dx * dx + dz * dz > m_RenderDistance * m_RenderDistance)
+        continue;
+
+      glm::ivec2 position = m_CenterChunk + glm::ivec2(dx, dz);
+      int64_t key = GetChunkKey(position.x, position.y);
+
+      if (m_Chunks.find(key) == m_Chunks.end() && m_PendingChunks.find(key) == m_PendingChunks.end())
+        m_ChunksToLoad.push_back(position);
     }
   }
 
-  // Constrói as meshes dos chunks
-  UpdateMeshes();
+  glm::ivec2 center = m_CenterChunk;
+
+  std::sort(m_ChunksToLoad.begin(), m_ChunksToLoad.end(), [center](const glm::ivec2 &a, const glm::ivec2 &b)
+            {
+              glm::ivec2 da = a - center;
+              glm::ivec2 db = b - center;
+
+              return da.x * da.x + da.y * da.y < db.x * db.x + db.y * db.y; });
 }
 
-World::~World()
+// Atualiza os chunks carregados de acordo com a posição da câmera
+void World::Update(glm::vec4 position)
 {
-  for (int x = 0; x < WorldConstants::CHUNKS_PER_AXIS; x++)
+  PROFILE_ZONE("World::Update");
+
+  glm::ivec2 centerChunk;
+
+  int blockX;
+  int blockZ;
+
+  SplitCoordinate((int)floorf(position.x), &centerChunk.x, &blockX);
+  SplitCoordinate((int)floorf(position.z), &centerChunk.y, &blockZ);
+
+  if (centerChunk != m_CenterChunk)
+  {
+    m_CenterChunk = centerChunk;
+    UpdateLoadQueue();
+  }
+
+  // Agenda a geração de alguns chunks por frame, começando pelos mais próximos
+  int requests = glm::min((int)m_ChunksToLoad.size(), WorldConstants::MAX_CHUNK_LOADS_PER_FRAME);
+
+  for (int i = 0; i < requests; i++)
+    RequestChunk(m_ChunksToLoad[i]);
+
+  m_ChunksToLoad.erase(m_ChunksToLoad.begin(), m_ChunksToLoad.begin() + requests);
+
+  // Adiciona ao mundo os chunks que terminaram de ser gerados
+  std::vector<Chunk *> generatedChunks;
+
   {
-    for (int z = 0; z < WorldConstants::CHUNKS_PER_AXIS; z++)
+    std::lock_guard<std::mutex> lock(m_GeneratedChunksMutex);
+    generatedChunks.swap(m_GeneratedChunks);
+  }
+
+  for (Chunk *chunk : generatedChunks)
+  {
+    m_PendingChunks.erase(GetChunkKey(chunk->GetChunkX(), chunk->GetChunkZ()));
+
+    // A câmera pode ter se afastado enquanto o chunk era gerado
+    if (!IsInUnloadDistance(chunk->GetChunkX(), chunk->GetChunkZ()))
     {
-      delete m_Chunks[x][z];
+      delete chunk;
+      continue;
     }
+
+    AddChunk(chunk);
   }
+
+  UpdateMeshes();
+
+  UploadMeshes(WorldConstants::MAX_MESH_UPLOADS_PER_FRAME);
+
+  // Chunks descarregados deixam buracos na arena; quando eles somam uma parte grande dela, as meshes são compactadas
+  if (m_VertexArena->IsFragmented())
+    m_VertexArena->Defragment();
+}
+
+void World::SetRenderDistance(int renderDistance)
+{
+  m_RenderDistance = renderDistance;
+
+  UpdateLoadQueue();
+}
+
+void World::MarkSectionsDirty(glm::ivec2 position, uint16_t sections, bool isPlayerEdit)
+{
+  Chunk *chunk = GetChunk(position.x, position.y);
+
+  if (chunk == nullptr)
+    return;
+
+  // O chunk só entra na lista na primeira marca; as seguintes são unidas na máscara dele
+  if (chunk->GetDirtySections() == 0)
+    m_ChunksToUpdate.push_back(position);
+
+  chunk->MarkSectionsDirty(sections, isPlayerEdit);
 }
 
-// Atualiza o mesh de um chunk
-void World::UpdateChunkMesh(glm::vec2 position)
+// Agenda a geração da mesh das seções de um chunk
+// A mesh só é construída quando os quatro vizinhos estão carregados, para não gerar faces na borda
+void World::RequestChunkMesh(Chunk *chunk, uint16_t sections, bool isPriority)
 {
-  int x = position.x;
-  int z = position.y;
+  glm::ivec2 position = glm::ivec2(chunk->GetChunkX(), chunk->GetChunkZ());
 
   std::array<Chunk *, 4> neighbors = GetNeighbors(position);
 
-  m_Chunks[x][z]->BuildMesh(neighbors);
+  for (Chunk *neighbor : neighbors)
+    if (neighbor == nullptr)
+      return;
+
+  // Só a mesh do pedido mais recente de cada seção é enviada; as anteriores ainda em geração são descartadas
+  chunk->SetSectionMeshVersion(sections, ++m_LastMeshVersion);
+
+  MeshedChunk *meshed;
+
+  if (m_FreeMeshBuffers.empty())
+  {
+    m_MeshBuffers.emplace_back(new MeshedChunk());
+    meshed = m_MeshBuffers.back().get();
+  }
+  else
+  {
+    meshed = m_FreeMeshBuffers.back();
+    m_FreeMeshBuffers.pop_back();
+  }
+
+  meshed->position = position;
+  meshed->sections = sections;
+  meshed->version = m_LastMeshVersion;
+  meshed->isPriority = isPriority;
+  meshed->voxelsVisited = 0;
+
+  // A thread de trabalho só lê a cópia, então o chunk pode ser editado ou descarregado durante a geração
+  std::shared_ptr<const ChunkSnapshot> snapshot = std::make_shared<ChunkSnapshot>(*chunk, neighbors, sections);
+  MeshingMode mode = m_MeshingMode;
+
+  m_ThreadPool->Submit([this, snapshot, meshed, mode]()
+                       {
+                         for (int section = 0; section < WorldConstants::SECTIONS_PER_CHUNK; section++)
+                           if (meshed->sections & (1 << section))
+                           {
+                             meshed->voxelsVisited += ChunkMesher::BuildMesh(*snapshot, section, mode, meshed->vertices[section], meshed->transparentVertices[section]);
+                             meshed->verticalBounds[section] = ChunkMesher::GetVerticalBounds(meshed->vertices[section], meshed->transparentVertices[section]);
+                             meshed->connectivity[section] = SectionVisibility::ComputeConnectivity(snapshot->GetSection(section));
+                           }
+
+                         std::lock_guard<std::mutex> lock(m_MeshedChunksMutex);
+                         m_MeshedChunks.push_back(meshed); },
+                       isPriority);
+}
+
+void World::UploadMeshes(int maxUploads)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_MeshedChunksMutex);
+
+    m_MeshUploadQueue.insert(m_MeshUploadQueue.end(), m_MeshedChunks.begin(), m_MeshedChunks.end());
+    m_MeshedChunks.clear();
+  }
+
+  int uploads = 0;
+  size_t remaining = 0;
+
+  for (MeshedChunk *meshed : m_MeshUploadQueue)
+  {
+    if (!meshed->isPriority && uploads >= maxUploads)
+    {
+      m_MeshUploadQueue[remaining++] = meshed;
+      continue;
+    }
+
+    if (meshed->isPriority)
+      m_EditVoxelsVisited += meshed->voxelsVisited;
+
+    Chunk *chunk = GetChunk(meshed->position.x, meshed->position.y);
+
+    // O chunk pode ter sido descarregado, ou as seções podem ter pedido uma mesh mais nova enquanto esta era gerada
+    if (chunk != nullptr)
+    {
+      bool isUploaded = false;
+
+      for (int section = 0; section < WorldConstants::SECTIONS_PER_CHUNK; section++)
+      {
+        if (!(meshed->sections & (1 << section)) || chunk->GetSectionMeshVersion(section) != meshed->version)
+          continue;
+
+        chunk->UploadMesh(m_VertexArena, section, meshed->vertices[section], meshed->transparentVertices[section], meshed->verticalBounds[section], meshed->connectivity[section]);
+        isUploaded = true;
+      }
+
+      if (isUploaded && !meshed->isPriority)
+        uploads++;
+    }
+
+    m_FreeMeshBuffers.push_back(meshed);
+  }
+
+  m_MeshUploadQueue.resize(remaining);
 }
 
-// Atualiza a mesh dos chunks que estão na lista de atualização
+// Agenda a mesh das seções marcadas de cada chunk na lista de atualização
 void World::UpdateMeshes()
 {
   for (auto &position : m_ChunksToUpdate)
-    UpdateChunkMesh(position);
+  {
+    Chunk *chunk = GetChunk(position.x, position.y);
+
+    if (chunk == nullptr || chunk->GetDirtySections() == 0)
+      continue;
+
+    uint16_t sections = chunk->GetDirtySections();
+    bool isPlayerEdit = chunk->IsDirtyByPlayer();
+
+    chunk->ClearDirtySections();
+
+    RequestChunkMesh(chunk, sections, isPlayerEdit);
+  }
 
   m_ChunksToUpdate.clear();
 }
 
-// Desenha o mundo
-void World::Draw(Camera *camera, glm::mat4 view, glm::mat4 projection)
+void World::FinishMeshes()
 {
-  m_Shader->Bind();
+  m_ThreadPool->Wait();
+
+  UploadMeshes(INT_MAX);
+}
 
-  m_Shader->SetUniformMat4f("uView", view);
-  m_Shader->SetUniformMat4f("uProjection", projection);
+void World::SetMeshingMode(MeshingMode mode)
+{
+  if (mode == m_MeshingMode)
+    return;
 
-  m_TextureAtlas->Bind(0);
-  m_Shader->SetUniform1i("uTexture", 0);
+  m_MeshingMode = mode;
+
+  for (auto &entry : m_Chunks)
+    MarkSectionsDirty(glm::ivec2(entry.second->GetChunkX(), entry.second->GetChunkZ()), Chunk::ALL_SECTIONS, false);
+
+  UpdateMeshes();
+  FinishMeshes();
+}
+
+size_t World::GetVertexCount() const
+{
+  size_t vertexCount = 0;
+
+  for (auto &chunk : m_Chunks)
+    vertexCount += chunk.second->GetVertexCount();
+
+  return vertexCount;
+}
+
+// Desenha o mundo
+void World::Draw(RenderQueue &queue, Camera *camera, glm::mat4 view, glm::mat4 projection)
+{
+  PROFILE_ZONE("World::Draw");
 
   glm::vec4 cameraPosition = camera->GetPosition();
 
-  std::vector<std::pair<float, Chunk *>> chunks;
+  glm::mat4 viewProjection = projection * view;
+
+  Frustum frustum(viewProjection);
+
+  m_CullingStats = CullingStats();
 
-  for (int x = 0; x < WorldConstants::CHUNKS_PER_AXIS; x++)
+  bool isCaveCulling = m_IsCaveCullingEnabled && FindReachableSections(glm::vec3(cameraPosition), frustum);
+
+  UpdateDrawOrder(glm::vec3(cameraPosition));
+
+  m_VisibleChunks.clear();
+
+  for (Chunk *chunk : m_DrawOrder)
   {
-    for (int z = 0; z < WorldConstants::CHUNKS_PER_AXIS; z++)
-    {
-      Chunk *chunk = m_Chunks[x][z];
+    glm::vec3 min;
+    glm::vec3 max;
 
-      float distance = glm::distance(glm::vec2(cameraPosition.x, cameraPosition.z), glm::vec2(x * WorldConstants::CHUNK_SIZE + WorldConstants::CHUNK_SIZE / 2, z * WorldConstants::CHUNK_SIZE + WorldConstants::CHUNK_SIZE / 2));
+    // Chunks na borda do raio ainda não têm mesh
+    if (!chunk->HasMesh() || !chunk->GetBox(&min, &max))
+      continue;
 
-      chunks.push_back(std::make_pair(distance, chunk));
+    if (!frustum.IsBoxVisible(min, max))
+    {
+      m_CullingStats.culledChunks++;
+      continue;
     }
+
+    m_VisibleChunks.push_back({chunk, 0});
+  }
+
+  // Rasteriza os oclusores dos chunks dentro do frustum antes de testar qualquer caixa
+  if (m_IsOcclusionCullingEnabled)
+  {
+    m_OcclusionBuffer.Clear(viewProjection, glm::vec3(cameraPosition));
+
+    for (const VisibleChunk &visible : m_VisibleChunks)
+      AddChunkOccluders(visible.chunk);
+
+    m_CullingStats.occluderTriangles = m_OcclusionBuffer.GetTriangleCount();
   }
 
-  // Ordena os chunks de acordo com a distância da câmera (mais longe )
-  std::sort(chunks.begin(), chunks.end(), [](const std::pair<float, Chunk *> &a, const std::pair<float, Chunk *> &b)
-            { return a.first > b.first; });
+  m_OpaqueDraws.Clear();
+  m_TransparentDraws.Clear();
 
-  // Com os chunks ordenados, para cada chunk chama a função de renderização
-  for (auto &chunk : chunks)
+  // A geometria opaca é desenhada da mais próxima para a mais distante, para o teste de profundidade
+  // descartar os fragmentos escondidos antes do fragment shader
+  for (VisibleChunk &visible : m_VisibleChunks)
   {
-    int chunkX = chunk.second->GetChunkX();
-    int chunkZ = chunk.second->GetChunkZ();
+    Chunk *chunk = visible.chunk;
+
+    glm::vec3 min;
+    glm::vec3 max;
+
+    chunk->GetBox(&min, &max);
+
+    uint16_t reachableSections = isCaveCulling ? chunk->GetReachableSections() : Chunk::ALL_SECTIONS;
+
+    if (reachableSections == 0)
+    {
+      m_CullingStats.unreachableChunks++;
+
+      for (int section = 0; section < WorldConstants::SECTIONS_PER_CHUNK; section++)
+        if (chunk->GetSectionBox(section, &min, &max))
+          m_CullingStats.unreachableSections++;
+
+      continue;
+    }
+
+    if (m_IsOcclusionCullingEnabled && m_OcclusionBuffer.IsBoxOccluded(min, max))
+    {
+      m_CullingStats.occludedChunks++;
 
-    // Translação para a posição do chunk
-    glm::mat4 model = Matrices::MatrixTranslate(chunkX * WorldConstants::CHUNK_SIZE, 0.0f, chunkZ * WorldConstants::CHUNK_SIZE);
+      for (int section = 0; section < WorldConstants::SECTIONS_PER_CHUNK; section++)
+        if (chunk->GetSectionBox(section, &min, &max))
+          m_CullingStats.occludedSections++;
+
+      continue;
+    }
 
-    m_Shader->SetUniformMat4f("uTransform", model);
+    m_CullingStats.visibleChunks++;
 
-    chunk.second->Draw(m_Shader);
+    // Seções com faces que estão dentro do frustum e não estão escondidas
+    for (int section = 0; section < WorldConstants::SECTIONS_PER_CHUNK; section++)
+    {
+      if (!chunk->GetSectionBox(section, &min, &max))
+        continue;
+
+      if (!frustum.IsBoxVisible(min, max))
+        m_CullingStats.culledSections++;
+      else if (!(reachableSections & (1 << section)))
+        m_CullingStats.unreachableSections++;
+      else if (m_IsOcclusionCullingEnabled && m_OcclusionBuffer.IsBoxOccluded(min, max))
+        m_CullingStats.occludedSections++;
+      else
+      {
+        m_CullingStats.visibleSections++;
+        visible.sections |= 1 << section;
+      }
+    }
+
+    chunk->AddOpaqueDraws(visible.sections, m_SectionOrder, m_OpaqueDraws);
   }
+
+  // A geometria transparente é misturada com o que já foi desenhado, então vai da mais distante para a mais próxima
+  for (auto visible = m_VisibleChunks.rbegin(); visible != m_VisibleChunks.rend(); ++visible)
+    visible->chunk->AddTransparentDraws(visible->sections, m_SectionOrder, m_TransparentDraws);
+
+  for (RenderPassStats &stats : m_PassStats)
+    stats = RenderPassStats();
+
+  SubmitPass(queue, DP_OPAQUE, m_OpaqueDraws);
+  SubmitPass(queue, DP_TRANSPARENT, m_TransparentDraws);
 }
 
-// Callback de raycast do mundo
-bool World::RayCastCallback(World *data, glm::vec4 position)
+void World::SubmitPass(RenderQueue &queue, DrawPass pass, const DrawList &list)
+{
+  RenderPassStats &stats = m_PassStats[pass];
+
+  if (list.GetSize() == 0)
+    return;
+
+  stats.drawCalls++;
+  stats.ranges += list.GetSize();
+
+  for (int count : list.counts)
+    stats.vertices += count;
+
+  DrawPacket packet;
+
+  packet.program = m_Shader->GetRendererId();
+  packet.vertexArray = m_VertexArena->GetVertexArrayId();
+
+  // A posição de cada chunk vem da origem da página da arena, então os chunks não precisam de uTransform
+  packet.AddTexture(0, GL_TEXTURE_2D, m_TextureAtlas->GetRendererId());
+  packet.AddTexture(1, GL_TEXTURE_BUFFER, m_VertexArena->GetPageOriginsId());
+
+  packet.AddUniform(m_IsOpaqueUniform, pass == DP_OPAQUE ? 1 : 0);
+
+  packet.command = DC_MULTI_ARRAYS;
+  packet.drawList = &list;
+
+  // As listas já estão ordenadas por distância, então o pacote inteiro fica na frente
+  queue.Submit(pass, 0.0f, packet);
+}
+
+void World::UpdateDrawOrder(glm::vec3 cameraPosition)
 {
-  int chunkX = (int)position.x / WorldConstants::CHUNK_SIZE;
-  int chunkZ = (int)position.z / WorldConstants::CHUNK_SIZE;
+  glm::ivec2 cameraChunk;
+
+  int blockX;
+  int blockZ;
 
-  int blockX = (int)position.x % WorldConstants::CHUNK_SIZE;
-  int blockZ = (int)position.z % WorldConstants::CHUNK_SIZE;
+  SplitCoordinate((int)floorf(cameraPosition.x), &cameraChunk.x, &blockX);
+  SplitCoordinate((int)floorf(cameraPosition.z), &cameraChunk.y, &blockZ);
 
-  if (blockX < 0)
+  // Ao atravessar a borda de um chunk a ordem muda pouco, e a lista é reordenada no mesmo vetor, sem alocar
+  if (cameraChunk != m_DrawOrderChunk)
   {
-    blockX += WorldConstants::CHUNK_SIZE;
-    chunkX--;
+    m_DrawOrderChunk = cameraChunk;
+
+    std::sort(m_DrawOrder.begin(), m_DrawOrder.end(), [this](const Chunk *a, const Chunk *b)
+              { return IsDrawnBefore(a, b); });
   }
 
-  if (blockZ < 0)
+  // Acima ou abaixo do mundo, a seção mais próxima é a do topo ou a da base
+  int section = glm::clamp((int)floorf(cameraPosition.y / WorldConstants::SECTION_HEIGHT), 0, WorldConstants::SECTIONS_PER_CHUNK - 1);
+
+  if (section != m_DrawOrderSection)
   {
-    blockZ += WorldConstants::CHUNK_SIZE;
-    chunkZ--;
+    m_DrawOrderSection = section;
+
+    for (int i = 0; i < WorldConstants::SECTIONS_PER_CHUNK; i++)
+      m_SectionOrder[i] = i;
+
+    std::sort(m_SectionOrder.begin(), m_SectionOrder.end(), [section](int a, int b)
+              {
+                int distanceA = abs(a - section);
+                int distanceB = abs(b - section);
+
+                return distanceA != distanceB ? distanceA < distanceB : a < b; });
   }
+}
 
-  if (chunkX < 0 || chunkX >= WorldConstants::CHUNKS_PER_AXIS || chunkZ < 0 || chunkZ >= WorldConstants::CHUNKS_PER_AXIS)
-  {
+bool World::FindReachableSections(glm::vec3 cameraPosition, const Frustum &frustum)
+{
+  int chunkX;
+  int chunkZ;
+
+  int blockX;
+  int blockZ;
+
+  SplitCoordinate((int)floorf(cameraPosition.x), &chunkX, &blockX);
+  SplitCoordinate((int)floorf(cameraPosition.z), &chunkZ, &blockZ);
+
+  int blockY = (int)floorf(cameraPosition.y);
+
+  // Acima ou abaixo do mundo as linhas de visão passam por fora das seções, então o percurso não é usado
+  if (GetChunk(chunkX, chunkZ) == nullptr || blockY < 0 || blockY >= WorldConstants::CHUNK_HEIGHT)
     return false;
-  }
 
-  // Se a posição de raycast é válida, busca o chunk
-  Chunk *chunk = data->m_Chunks[chunkX][chunkZ];
+  int section = blockY / WorldConstants::SECTION_HEIGHT;
+
+  glm::ivec3 start = glm::ivec3(chunkX, section, chunkZ);
+
+  for (Chunk *chunk : m_DrawOrder)
+    chunk->ClearReachableSections();
+
+  SectionVisibility::Traverse(
+      start, m_RenderDistance + WorldConstants::UNLOAD_DISTANCE_MARGIN,
+      [this](glm::ivec3 position)
+      {
+        Chunk *chunk = GetChunk(position.x, position.z);
+
+        return chunk != nullptr ? (int)chunk->GetSectionConnectivity(position.y) : -1;
+      },
+      [this, &frustum, start](glm::ivec3 position)
+      {
+        glm::ivec3 distance = glm::abs(position - start);
+
+        // As seções ao redor da câmera podem estar entre ela e o plano near, então não são testadas contra o frustum
+        if (distance.x > 1 || distance.y > 1 || distance.z > 1)
+        {
+          glm::vec3 min = glm::vec3(position.x * WorldConstants::CHUNK_SIZE, position.y * WorldConstants::SECTION_HEIGHT, position.z * WorldConstants::CHUNK_SIZE);
+          glm::vec3 max = min + glm::vec3(WorldConstants::CHUNK_SIZE, WorldConstants::SECTION_HEIGHT, WorldConstants::CHUNK_SIZE);
 
-  int blockY = (int)position.y;
+          if (!frustum.IsBoxVisible(min, max))
+            return false;
+        }
 
-  if (blockY < 0 || blockY >= WorldConstants::CHUNK_HEIGHT)
+        GetChunk(position.x, position.z)->AddReachableSection(position.y);
+        m_CullingStats.traversedSections++;
+
+        return true;
+      });
+
+  return true;
+}
+
+void World::AddChunkOccluders(Chunk *chunk)
+{
+  const float inset = WorldConstants::OCCLUDER_INSET;
+
+  glm::vec3 origin = glm::vec3(chunk->GetChunkX() * WorldConstants::CHUNK_SIZE, 0.0f, chunk->GetChunkZ() * WorldConstants::CHUNK_SIZE);
+
+  int minHullHeight = WorldConstants::CHUNK_HEIGHT;
+
+  // Uma caixa por retângulo de células do casco com a mesma altura, da base do mundo até a altura
+  // em que todas as colunas das células são opacas; unir as células reduz os triângulos rasterizados
+  std::array<bool, Chunk::HULL_CELLS * Chunk::HULL_CELLS> isCellAdded = {};
+
+  for (int cellZ = 0; cellZ < Chunk::HULL_CELLS; cellZ++)
   {
-    return false;
+    for (int cellX = 0; cellX < Chunk::HULL_CELLS; cellX++)
+    {
+      int hullHeight = chunk->GetHullHeight(cellX, cellZ);
+
+      minHullHeight = glm::min(minHullHeight, hullHeight);
+
+      if (isCellAdded[cellZ * Chunk::HULL_CELLS + cellX] || hullHeight == 0)
+        continue;
+
+      int width = 1;
+
+      while (cellX + width < Chunk::HULL_CELLS && !isCellAdded[cellZ * Chunk::HULL_CELLS + cellX + width] && chunk->GetHullHeight(cellX + width, cellZ) == hullHeight)
+        width++;
+
+      int depth = 1;
+
+      for (; cellZ + depth < Chunk::HULL_CELLS; depth++)
+      {
+        bool isRowEqual = true;
+
+        for (int i = 0; i < width && isRowEqual; i++)
+          isRowEqual = !isCellAdded[(cellZ + depth) * Chunk::HULL_CELLS + cellX + i] && chunk->GetHullHeight(cellX + i, cellZ + depth) == hullHeight;
+
+        if (!isRowEqual)
+          break;
+      }
+
+      for (int j = 0; j < depth; j++)
+        for (int i = 0; i < width; i++)
+          isCellAdded[(cellZ + j) * Chunk::HULL_CELLS + cellX + i] = true;
+
+      glm::vec3 cell = origin + glm::vec3(cellX * Chunk::HULL_CELL_SIZE, 0.0f, cellZ * Chunk::HULL_CELL_SIZE);
+      glm::vec3 size = glm::vec3(width * Chunk::HULL_CELL_SIZE, hullHeight, depth * Chunk::HULL_CELL_SIZE);
+
+      m_OcclusionBuffer.AddOccluder(cell + glm::vec3(inset, 0.0f, inset), cell + size - glm::vec3(inset));
+    }
+  }
+
+  // Seções totalmente opacas que não estão dentro do casco
+  for (int section = 0; section < WorldConstants::SECTIONS_PER_CHUNK; section++)
+  {
+    int bottom = section * WorldConstants::SECTION_HEIGHT;
+    int top = bottom + WorldConstants::SECTION_HEIGHT;
+
+    if (top <= minHullHeight || !chunk->GetSection(section).IsFullyOpaque())
+      continue;
+
+    m_OcclusionBuffer.AddOccluder(origin + glm::vec3(inset, bottom + inset, inset), origin + glm::vec3(WorldConstants::CHUNK_SIZE - inset, top - inset, WorldConstants::CHUNK_SIZE - inset));
   }
+}
 
+// Callback de raycast do mundo
+bool World::RayCastCallback(World *data, glm::vec4 position)
+{
   // Se o bloco na posição de raycast não é ar ou água, retorna true
-  int block = chunk->GetCube(glm::vec3(blockX, blockY, blockZ));
+  int block = data->GetBlock(glm::vec3(position));
 
   return block != AIR && block != WATER;
 }
@@ -145,93 +772,103 @@ bool World::RayCastCallback(World *data, glm::vec4 position)
 // Atualiza um bloco no mundo
 void World::SetBlock(glm::vec3 position, int block)
 {
-  int chunkX = (int)position.x / WorldConstants::CHUNK_SIZE;
-  int chunkZ = (int)position.z / WorldConstants::CHUNK_SIZE;
+  int chunkX;
+  int chunkZ;
 
-  int blockX = (int)position.x % WorldConstants::CHUNK_SIZE;
-  int blockZ = (int)position.z % WorldConstants::CHUNK_SIZE;
+  int blockX;
+  int blockZ;
 
-  bool isChunkXValid = chunkX >= 0 && chunkX < WorldConstants::CHUNKS_PER_AXIS;
-  bool isChunkZValid = chunkZ >= 0 && chunkZ < WorldConstants::CHUNKS_PER_AXIS;
+  SplitCoordinate((int)floorf(position.x), &chunkX, &blockX);
+  SplitCoordinate((int)floorf(position.z), &chunkZ, &blockZ);
 
-  if (!isChunkXValid || !isChunkZValid)
-    return;
+  Chunk *chunk = GetChunk(chunkX, chunkZ);
 
-  Chunk *chunk = m_Chunks[chunkX][chunkZ];
+  if (chunk == nullptr)
+    return;
 
-  int blockY = (int)position.y;
+  int blockY = (int)floorf(position.y);
 
   bool isBlockYValid = blockY >= 0 && blockY < WorldConstants::CHUNK_HEIGHT;
 
   if (!isBlockYValid)
     return;
 
-  chunk->SetCube(glm::vec3(blockX, blockY, blockZ), block);
+  chunk->SetCube(blockX, blockY, blockZ, block);
+  chunk->MarkModified();
 
-  // Adiciona o chunk modificado na lista de atualização
-  m_ChunksToUpdate.push_back(glm::vec2(chunkX, chunkZ));
+  m_EditCount++;
 
-  // Adiciona os chunks vizinhos na lista de atualização, se necessário
-  if (blockX == 0 && chunkX - 1 >= 0)
-    m_ChunksToUpdate.push_back(glm::vec2(chunkX - 1, chunkZ));
+  // Marca a seção do bloco, a seção vizinha se o bloco está na borda vertical dela
+  // e a mesma seção dos chunks vizinhos se o bloco está na borda horizontal do chunk
+  int section = blockY / WorldConstants::SECTION_HEIGHT;
+  int sectionY = blockY % WorldConstants::SECTION_HEIGHT;
 
-  if (blockX == WorldConstants::CHUNK_SIZE - 1 && chunkX + 1 < WorldConstants::CHUNKS_PER_AXIS)
-    m_ChunksToUpdate.push_back(glm::vec2(chunkX + 1, chunkZ));
+  uint16_t sections = 1 << section;
 
-  if (blockZ == 0 && chunkZ - 1 >= 0)
-    m_ChunksToUpdate.push_back(glm::vec2(chunkX, chunkZ - 1));
+  if (sectionY == 0 && section > 0)
+    sections |= 1 << (section - 1);
 
-  if (blockZ == WorldConstants::CHUNK_SIZE - 1 && chunkZ + 1 < WorldConstants::CHUNKS_PER_AXIS)
-    m_ChunksToUpdate.push_back(glm::vec2(chunkX, chunkZ + 1));
+  if (sectionY == WorldConstants::SECTION_HEIGHT - 1 && section < WorldConstants::SECTIONS_PER_CHUNK - 1)
+    sections |= 1 << (section + 1);
 
-  // Atualiza a mesh dos chunks
-  UpdateMeshes();
+  MarkSectionsDirty(glm::ivec2(chunkX, chunkZ), sections, true);
+
+  if (blockX == 0)
+    MarkSectionsDirty(glm::ivec2(chunkX - 1, chunkZ), 1 << section, true);
+
+  if (blockX == WorldConstants::CHUNK_SIZE - 1)
+    MarkSectionsDirty(glm::ivec2(chunkX + 1, chunkZ), 1 << section, true);
+
+  if (blockZ == 0)
+    MarkSectionsDirty(glm::ivec2(chunkX, chunkZ - 1), 1 << section, true);
+
+  if (blockZ == WorldConstants::CHUNK_SIZE - 1)
+    MarkSectionsDirty(glm::ivec2(chunkX, chunkZ + 1), 1 << section, true);
+
+  // As meshes são agendadas com prioridade no próximo World::Update, uma vez por frame,
+  // então várias edições no mesmo chunk geram um único pedido
 }
 
 // Retorna o bloco na posição especificada
 int World::GetBlock(glm::vec3 position)
 {
-  int chunkX = (int)position.x / WorldConstants::CHUNK_SIZE;
-  int chunkZ = (int)position.z / WorldConstants::CHUNK_SIZE;
+  int chunkX;
+  int chunkZ;
 
-  int blockX = (int)position.x % WorldConstants::CHUNK_SIZE;
-  int blockZ = (int)position.z % WorldConstants::CHUNK_SIZE;
+  int blockX;
+  int blockZ;
 
-  if (blockX < 0)
-  {
-    blockX += WorldConstants::CHUNK_SIZE;
-    chunkX--;
-  }
+  SplitCoordinate((int)floorf(position.x), &chunkX, &blockX);
+  SplitCoordinate((int)floorf(position.z), &chunkZ, &blockZ);
 
-  if (blockZ < 0)
-  {
-    blockZ += WorldConstants::CHUNK_SIZE;
-    chunkZ--;
-  }
+  Chunk *chunk = GetChunk(chunkX, chunkZ);
 
-  if (chunkX < 0 || chunkX >= WorldConstants::CHUNKS_PER_AXIS || chunkZ < 0 || chunkZ >= WorldConstants::CHUNKS_PER_AXIS)
+  if (chunk == nullptr)
   {
     return AIR;
   }
 
-  Chunk *chunk = m_Chunks[chunkX][chunkZ];
+  return chunk->GetCube(blockX, (int)floorf(position.y), blockZ);
+}
 
-  int blockY = (int)position.y;
+Chunk *World::GetChunk(int chunkX, int chunkZ)
+{
+  auto it = m_Chunks.find(GetChunkKey(chunkX, chunkZ));
 
-  if (blockY < 0 || blockY >= WorldConstants::CHUNK_HEIGHT)
+  if (it == m_Chunks.end())
   {
-    return AIR;
+    return nullptr;
   }
 
-  return chunk->GetCube(glm::vec3(blockX, blockY, blockZ));
+  return it->second;
 }
 
-Chunk *World::GetChunk(int chunkX, int chunkZ)
+size_t World::GetMemoryUsage() const
 {
-  if (chunkX < 0 || chunkX >= WorldConstants::CHUNKS_PER_AXIS || chunkZ < 0 || chunkZ >= WorldConstants::CHUNKS_PER_AXIS)
-  {
-    return nullptr;
-  }
+  size_t memory = 0;
+
+  for (auto &chunk : m_Chunks)
+    memory += chunk.second->GetMemoryUsage();
 
-  return m_Chunks[chunkX][chunkZ];
+  return memory;
 }
\ No newline at end of file
@@ -0,0 +1,198 @@
+#include "Test.hpp"
+
+#include "core/BufferAllocator.hpp"
+
+TEST(BufferAllocatorAllocatesInOrder)
+{
+  BufferAllocator allocator(100);
+
+  int a = allocator.Allocate(10);
+  int b = allocator.Allocate(20);
+
+  CHECK(a != BufferAllocator::INVALID && b != BufferAllocator::INVALID && a != b);
+  CHECK(allocator.GetOffset(a) == 0 && allocator.GetSize(a) == 10);
+  CHECK(allocator.GetOffset(b) == 10 && allocator.GetSize(b) == 20);
+  CHECK(allocator.GetUsed() == 30 && allocator.GetFree() == 70);
+  CHECK(allocator.GetAllocationCount() == 2);
+
+  // Tamanhos inválidos e maiores que o espaço livre
+  CHECK(allocator.Allocate(0) == BufferAllocator::INVALID);
+  CHECK(allocator.Allocate(71) == BufferAllocator::INVALID);
+  CHECK(allocator.GetAllocationCount() == 2);
+}
+
+TEST(BufferAllocatorBestFit)
+{
+  BufferAllocator allocator(100);
+
+  int blocks[7];
+  int sizes[7] = {10, 10, 5, 10, 5, 10, 50};
+
+  for (int i = 0; i < 7; i++)
+    blocks[i] = allocator.Allocate(sizes[i]);
+
+  // Buracos de 10, 5 e 5 unidades em [0, 10), [20, 25) e [35, 40)
+  allocator.Free(blocks[0]);
+  allocator.Free(blocks[2]);
+  allocator.Free(blocks[4]);
+
+  CHECK(allocator.GetFreeBlockCount() == 3);
+
+  // O menor bloco que comporta a alocação, o de menor posição no empate
+  int small = allocator.Allocate(4);
+  CHECK(allocator.GetOffset(small) == 20);
+
+  int exact = allocator.Allocate(5);
+  CHECK(allocator.GetOffset(exact) == 35);
+
+  int large = allocator.Allocate(10);
+  CHECK(allocator.GetOffset(large) == 0);
+
+  // Sobra uma unidade em [24, 25), que não comporta 2
+  CHECK(allocator.GetFreeBlockCount() == 1);
+  CHECK(allocator.Allocate(2) == BufferAllocator::INVALID);
+  CHECK(allocator.GetLargestFreeBlock() == 1);
+}
+
+TEST(BufferAllocatorCoalescesFreeBlocks)
+{
+  BufferAllocator allocator(40);
+
+  int a = allocator.Allocate(10);
+  int b = allocator.Allocate(10);
+  int c = allocator.Allocate(10);
+  int d = allocator.Allocate(10);
+
+  allocator.Free(a);
+  allocator.Free(c);
+
+  CHECK(allocator.GetFreeBlockCount() == 2);
+  CHECK(allocator.GetLargestFreeBlock() == 10);
+  CHECK_NEAR(allocator.GetFragmentation(), 0.5f, 1e-6f);
+
+  // Liberar b une o bloco com os dois vizinhos livres
+  allocator.Free(b);
+
+  CHECK(allocator.GetFreeBlockCount() == 1);
+  CHECK(allocator.GetLargestFreeBlock() == 30);
+  CHECK(allocator.GetFragmentation() == 0.0f);
+
+  // Liberar d une com o bloco anterior, até o fim do intervalo
+  allocator.Free(d);
+
+  CHECK(allocator.GetFreeBlockCount() == 1);
+  CHECK(allocator.GetLargestFreeBlock() == 40);
+  CHECK(allocator.GetUsed() == 0 && allocator.GetAllocationCount() == 0);
+
+  int whole = allocator.Allocate(40);
+  CHECK(whole != BufferAllocator::INVALID && allocator.GetOffset(whole) == 0);
+}
+
+TEST(BufferAllocatorReusesHandles)
+{
+  BufferAllocator allocator(30);
+
+  int a = allocator.Allocate(10);
+  allocator.Allocate(10);
+
+  allocator.Free(a);
+
+  // O handle liberado volta a ser usado, e o handle antigo fica com tamanho zero até lá
+  CHECK(allocator.GetSize(a) == 0);
+  CHECK(allocator.Allocate(5) == a);
+  CHECK(allocator.GetSize(a) == 5);
+}
+
+TEST(BufferAllocatorGrow)
+{
+  BufferAllocator allocator(20);
+
+  int a = allocator.Allocate(20);
+  CHECK(allocator.Allocate(1) == BufferAllocator::INVALID);
+
+  allocator.Grow(50);
+
+  CHECK(allocator.GetCapacity() == 50 && allocator.GetFree() == 30);
+
+  int b = allocator.Allocate(30);
+  CHECK(allocator.GetOffset(b) == 20);
+
+  // O último bloco livre é estendido em vez de criar um segundo bloco
+  allocator.Free(b);
+  allocator.Grow(60);
+
+  CHECK(allocator.GetFreeBlockCount() == 1);
+  CHECK(allocator.GetLargestFreeBlock() == 40);
+
+  // Capacidades menores ou iguais não mudam nada
+  allocator.Grow(10);
+
+  CHECK(allocator.GetCapacity() == 60);
+  CHECK(allocator.GetOffset(a) == 0 && allocator.GetSize(a) == 20);
+}
+
+TEST(BufferAllocatorDefragment)
+{
+  BufferAllocator allocator(100);
+
+  int a = allocator.Allocate(10);
+  int b = allocator.Allocate(20);
+  int c = allocator.Allocate(5);
+  int d = allocator.Allocate(15);
+  int e = allocator.Allocate(10);
+
+  allocator.Free(b);
+  allocator.Free(d);
+
+  // a fica no lugar; c de 30 para 10 e e de 50 para 15
+  std::vector<BufferAllocator::Move> moves = allocator.Defragment();
+
+  CHECK(moves.size() == 2);
+
+  if (moves.size() == 2)
+  {
+    CHECK(moves[0].handle == c && moves[0].oldOffset == 30 && moves[0].newOffset == 10 && moves[0].size == 5);
+    CHECK(moves[1].handle == e && moves[1].oldOffset == 50 && moves[1].newOffset == 15 && moves[1].size == 10);
+  }
+
+  CHECK(allocator.GetOffset(a) == 0);
+  CHECK(allocator.GetOffset(c) == 10);
+  CHECK(allocator.GetOffset(e) == 15);
+
+  CHECK(allocator.GetFreeBlockCount() == 1);
+  CHECK(allocator.GetLargestFreeBlock() == 75);
+  CHECK(allocator.GetFragmentation() == 0.0f);
+
+  // Sem buracos, nada se move
+  CHECK(allocator.Defragment().empty());
+}
+
+TEST(BufferAllocatorDefragmentKeepsOffsetOrder)
+{
+  BufferAllocator allocator(60);
+
+  int a = allocator.Allocate(10);
+  int b = allocator.Allocate(10);
+  int c = allocator.Allocate(10);
+
+  // O handle de a é reaproveitado por uma alocação depois de c
+  allocator.Free(a);
+  int d = allocator.Allocate(20);
+  allocator.Free(b);
+
+  CHECK(d == a);
+  CHECK(allocator.GetOffset(d) == 30);
+
+  // A ordem é a das posições, não a dos handles
+  std::vector<BufferAllocator::Move> moves = allocator.Defragment();
+
+  CHECK(moves.size() == 2);
+
+  if (moves.size() == 2)
+  {
+    CHECK(moves[0].handle == c && moves[0].oldOffset == 20 && moves[0].newOffset == 0);
+    CHECK(moves[1].handle == d && moves[1].oldOffset == 30 && moves[1].newOffset == 10 && moves[1].size == 20);
+  }
+
+  CHECK(allocator.GetLargestFreeBlock() == 30);
+}
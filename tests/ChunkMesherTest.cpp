@@ -0,0 +1,91 @@
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+#include "Test.hpp"
+
+#include "world/BlockDatabase.hpp"
+#include "world/Chunk.hpp"
+#include "world/ChunkMesher.hpp"
+
+// Alocações feitas pelo operator new global em todo o programa de testes
+static std::atomic<long> heapAllocations(0);
+
+void *operator new(std::size_t size)
+{
+  heapAllocations.fetch_add(1, std::memory_order_relaxed);
+
+  if (void *pointer = std::malloc(size ? size : 1))
+    return pointer;
+
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void *pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+  std::free(pointer);
+}
+
+// Depois de um aquecimento com o mesmo snapshot e os mesmos vetores de saída,
+// gerar a mesh de novo não pode fazer nenhuma alocação no heap
+static void CheckBuildMeshDoesNotAllocate(MeshingMode mode)
+{
+  const int chunkX = WorldConstants::CHUNKS_PER_AXIS / 2;
+  const int chunkZ = WorldConstants::CHUNKS_PER_AXIS / 2;
+  const int builds = 20;
+
+  BlockDatabase::Initialize();
+
+  // Chunks grandes demais para a pilha
+  std::unique_ptr<Chunk> chunk(new Chunk(chunkX, chunkZ));
+  std::unique_ptr<Chunk> west(new Chunk(chunkX - 1, chunkZ));
+  std::unique_ptr<Chunk> south(new Chunk(chunkX, chunkZ + 1));
+  std::unique_ptr<Chunk> east(new Chunk(chunkX + 1, chunkZ));
+  std::unique_ptr<Chunk> north(new Chunk(chunkX, chunkZ - 1));
+
+  std::array<Chunk *, 4> neighbors = {west.get(), south.get(), east.get(), north.get()};
+  std::unique_ptr<ChunkSnapshot> snapshot(new ChunkSnapshot(*chunk, neighbors));
+
+  std::vector<CubeVertex> vertices;
+  std::vector<CubeVertex> transparentVertices;
+
+  size_t warmUpVertices = 0;
+
+  for (int section = 0; section < WorldConstants::SECTIONS_PER_CHUNK; section++)
+  {
+    ChunkMesher::BuildMesh(*snapshot, section, mode, vertices, transparentVertices);
+    warmUpVertices += vertices.size() + transparentVertices.size();
+  }
+
+  // O snapshot fixo precisa gerar faces para o teste medir alguma coisa
+  CHECK(warmUpVertices > 0);
+
+  long allocationsBefore = heapAllocations.load();
+
+  for (int build = 0; build < builds; build++)
+    for (int section = 0; section < WorldConstants::SECTIONS_PER_CHUNK; section++)
+      ChunkMesher::BuildMesh(*snapshot, section, mode, vertices, transparentVertices);
+
+  CHECK(heapAllocations.load() - allocationsBefore == 0);
+}
+
+TEST(NaiveBuildMeshDoesNotAllocate)
+{
+  CheckBuildMeshDoesNotAllocate(MM_NAIVE);
+}
+
+TEST(GreedyBuildMeshDoesNotAllocate)
+{
+  CheckBuildMeshDoesNotAllocate(MM_GREEDY);
+}
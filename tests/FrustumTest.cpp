@@ -0,0 +1,98 @@
+#include <algorithm>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Test.hpp"
+
+#include "core/Frustum.hpp"
+
+// Câmera na origem olhando para -z, com 90 graus de abertura, near 1 e far 100
+// Nessa câmera os lados do frustum são os planos x = ±z e y = ±z
+static glm::mat4 GetTestViewProjection()
+{
+  glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 1.0f, 100.0f);
+  glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+  return projection * view;
+}
+
+// Plano com a normal de comprimento um, para comparar com os planos esperados
+static glm::vec4 NormalizePlane(const glm::vec4 &plane)
+{
+  return plane / glm::length(glm::vec3(plane));
+}
+
+static void CheckPlane(const Frustum &frustum, int plane, glm::vec4 expected)
+{
+  glm::vec4 normalized = NormalizePlane(frustum.GetPlane(plane));
+
+  expected = NormalizePlane(expected);
+
+  // O d do far é grande, então a tolerância é relativa
+  for (int i = 0; i < 4; i++)
+    CHECK_NEAR(normalized[i], expected[i], 1e-4f * std::max(1.0f, std::fabs(expected[i])));
+}
+
+TEST(FrustumExtractsPlanes)
+{
+  Frustum frustum(GetTestViewProjection());
+
+  // Esquerda, direita, baixo, cima, near e far, com a normal para dentro
+  CheckPlane(frustum, 0, glm::vec4(1.0f, 0.0f, -1.0f, 0.0f));
+  CheckPlane(frustum, 1, glm::vec4(-1.0f, 0.0f, -1.0f, 0.0f));
+  CheckPlane(frustum, 2, glm::vec4(0.0f, 1.0f, -1.0f, 0.0f));
+  CheckPlane(frustum, 3, glm::vec4(0.0f, -1.0f, -1.0f, 0.0f));
+  CheckPlane(frustum, 4, glm::vec4(0.0f, 0.0f, -1.0f, -1.0f));
+  CheckPlane(frustum, 5, glm::vec4(0.0f, 0.0f, 1.0f, 100.0f));
+}
+
+TEST(FrustumBoxInside)
+{
+  Frustum frustum(GetTestViewProjection());
+
+  CHECK(frustum.IsBoxVisible(glm::vec3(-1.0f, -1.0f, -11.0f), glm::vec3(1.0f, 1.0f, -9.0f)));
+  CHECK(frustum.IsBoxVisible(glm::vec3(3.0f, 3.0f, -6.0f), glm::vec3(4.0f, 4.0f, -5.0f)));
+  CHECK(frustum.IsBoxVisible(glm::vec3(-0.5f, -0.5f, -99.0f), glm::vec3(0.5f, 0.5f, -98.0f)));
+}
+
+TEST(FrustumBoxOutside)
+{
+  Frustum frustum(GetTestViewProjection());
+
+  // Atrás da câmera, mais perto que o near e além do far
+  CHECK(!frustum.IsBoxVisible(glm::vec3(-1.0f, -1.0f, 5.0f), glm::vec3(1.0f, 1.0f, 7.0f)));
+  CHECK(!frustum.IsBoxVisible(glm::vec3(-0.1f, -0.1f, -0.9f), glm::vec3(0.1f, 0.1f, -0.5f)));
+  CHECK(!frustum.IsBoxVisible(glm::vec3(-1.0f, -1.0f, -120.0f), glm::vec3(1.0f, 1.0f, -101.0f)));
+
+  // Fora de cada um dos lados
+  CHECK(!frustum.IsBoxVisible(glm::vec3(-20.0f, -1.0f, -11.0f), glm::vec3(-12.0f, 1.0f, -9.0f)));
+  CHECK(!frustum.IsBoxVisible(glm::vec3(12.0f, -1.0f, -11.0f), glm::vec3(20.0f, 1.0f, -9.0f)));
+  CHECK(!frustum.IsBoxVisible(glm::vec3(-1.0f, -20.0f, -11.0f), glm::vec3(1.0f, -12.0f, -9.0f)));
+  CHECK(!frustum.IsBoxVisible(glm::vec3(-1.0f, 12.0f, -11.0f), glm::vec3(1.0f, 20.0f, -9.0f)));
+}
+
+TEST(FrustumBoxStraddling)
+{
+  Frustum frustum(GetTestViewProjection());
+
+  // Cruzando o near, o far e um dos lados
+  CHECK(frustum.IsBoxVisible(glm::vec3(-1.0f, -1.0f, -2.0f), glm::vec3(1.0f, 1.0f, 2.0f)));
+  CHECK(frustum.IsBoxVisible(glm::vec3(-1.0f, -1.0f, -110.0f), glm::vec3(1.0f, 1.0f, -90.0f)));
+  CHECK(frustum.IsBoxVisible(glm::vec3(-20.0f, -1.0f, -11.0f), glm::vec3(-8.0f, 1.0f, -9.0f)));
+
+  // Maior que o frustum inteiro
+  CHECK(frustum.IsBoxVisible(glm::vec3(-500.0f), glm::vec3(500.0f)));
+}
+
+TEST(FrustumFollowsView)
+{
+  // Câmera em (10, 0, 0) olhando para +x: a mesma caixa passa a estar atrás dela
+  glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 1.0f, 100.0f);
+  glm::mat4 view = glm::lookAt(glm::vec3(10.0f, 0.0f, 0.0f), glm::vec3(11.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+  Frustum frustum(projection * view);
+
+  CHECK(frustum.IsBoxVisible(glm::vec3(19.0f, -1.0f, -1.0f), glm::vec3(21.0f, 1.0f, 1.0f)));
+  CHECK(!frustum.IsBoxVisible(glm::vec3(-1.0f, -1.0f, -11.0f), glm::vec3(1.0f, 1.0f, -9.0f)));
+  CHECK(!frustum.IsBoxVisible(glm::vec3(0.0f, -1.0f, -1.0f), glm::vec3(5.0f, 1.0f, 1.0f)));
+}
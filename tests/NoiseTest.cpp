@@ -0,0 +1,54 @@
+#include "Test.hpp"
+
+#include "world/Noise.hpp"
+#include "world/WorldConstants.hpp"
+
+// Compara a grade (SSE quando disponível) com o GetNoise escalar em cada posição
+static void CheckGridMatchesScalar(const Noise &noise, glm::vec2 origin, int width, int height)
+{
+  std::vector<float> grid(width * height);
+
+  noise.GetNoiseGrid(origin, width, height, grid.data());
+
+  for (int z = 0; z < height; z++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      float scalar = noise.GetNoise(origin + glm::vec2(x, z));
+
+      CHECK_NEAR(grid[x + z * width], scalar, Noise::GRID_TOLERANCE);
+    }
+  }
+}
+
+TEST(NoiseGridMatchesScalar)
+{
+  // Configurações do terreno e oitavas nos extremos
+  const Noise configurations[] = {
+      Noise(8500, 6, 105.0f, 205.0f, 0.58f, 18),
+      Noise(8500, 4, 20.0f, 200.0f, 0.45f, 0),
+      Noise(1, 1, 1.0f, 1.0f, 0.5f, 0),
+      Noise(1234, 8, 64.0f, 32.0f, 0.7f, 5),
+  };
+
+  const glm::vec2 chunkOrigins[] = {
+      glm::vec2(0, 0),
+      glm::vec2(5, -3),
+      glm::vec2(-100, 37),
+      glm::vec2(63, 63),
+      glm::vec2(1000, -1000),
+  };
+
+  for (const Noise &noise : configurations)
+  {
+    for (glm::vec2 chunk : chunkOrigins)
+    {
+      glm::vec2 origin = chunk * static_cast<float>(WorldConstants::CHUNK_SIZE);
+
+      CheckGridMatchesScalar(noise, origin, 16, 16);
+
+      // Largura que não é múltipla de 4 passa também pelo caminho escalar do resto da linha
+      CheckGridMatchesScalar(noise, origin + glm::vec2(0.5f, 0.25f), 13, 3);
+    }
+  }
+}
@@ -0,0 +1,84 @@
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Test.hpp"
+
+#include "core/OcclusionBuffer.hpp"
+
+// Mesma câmera dos testes do frustum: na origem olhando para -z, 90 graus, near 1 e far 100
+// A z = -5 a tela vai de -5 a 5 em x e em y
+static void ClearWithTestCamera(OcclusionBuffer &buffer)
+{
+  glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 1.0f, 100.0f);
+  glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+  buffer.Clear(projection * view, glm::vec3(0.0f));
+}
+
+TEST(OcclusionEmptyBufferOccludesNothing)
+{
+  OcclusionBuffer buffer;
+  ClearWithTestCamera(buffer);
+
+  CHECK(!buffer.IsBoxOccluded(glm::vec3(-1.0f, -1.0f, -20.0f), glm::vec3(1.0f, 1.0f, -18.0f)));
+  CHECK(buffer.GetTriangleCount() == 0);
+}
+
+TEST(OcclusionFullScreenOccluder)
+{
+  OcclusionBuffer buffer;
+  ClearWithTestCamera(buffer);
+
+  // Parede fina que cobre a tela inteira: só a face voltada para a câmera é rasterizada, em dois triângulos
+  buffer.AddOccluder(glm::vec3(-50.0f, -50.0f, -6.0f), glm::vec3(50.0f, 50.0f, -5.0f));
+
+  CHECK(buffer.GetTriangleCount() == 2);
+
+  // Todos os pixels, inclusive a guard band, ficam com a profundidade da parede
+  bool isCovered = true;
+
+  for (int y = 0; y < OcclusionBuffer::HEIGHT; y++)
+    for (int x = 0; x < OcclusionBuffer::WIDTH; x++)
+      isCovered = isCovered && buffer.GetDepth(x, y) < 1.0f;
+
+  CHECK(isCovered);
+
+  // Atrás da parede, no centro e na borda da tela
+  CHECK(buffer.IsBoxOccluded(glm::vec3(-1.0f, -1.0f, -20.0f), glm::vec3(1.0f, 1.0f, -18.0f)));
+  CHECK(buffer.IsBoxOccluded(glm::vec3(15.0f, -1.0f, -20.0f), glm::vec3(19.0f, 1.0f, -18.0f)));
+
+  // Na frente da parede, atravessando a parede e cruzando o plano near
+  CHECK(!buffer.IsBoxOccluded(glm::vec3(-1.0f, -1.0f, -4.0f), glm::vec3(1.0f, 1.0f, -3.0f)));
+  CHECK(!buffer.IsBoxOccluded(glm::vec3(-1.0f, -1.0f, -8.0f), glm::vec3(1.0f, 1.0f, -4.0f)));
+  CHECK(!buffer.IsBoxOccluded(glm::vec3(-1.0f, -1.0f, -20.0f), glm::vec3(1.0f, 1.0f, 1.0f)));
+}
+
+TEST(OcclusionPartialOccluder)
+{
+  OcclusionBuffer buffer;
+  ClearWithTestCamera(buffer);
+
+  // Parede que cobre só a metade esquerda da tela
+  buffer.AddOccluder(glm::vec3(-50.0f, -50.0f, -6.0f), glm::vec3(0.0f, 50.0f, -5.0f));
+
+  // Inteiramente atrás da metade coberta
+  CHECK(buffer.IsBoxOccluded(glm::vec3(-8.0f, -1.0f, -20.0f), glm::vec3(-4.0f, 1.0f, -18.0f)));
+
+  // Parcialmente coberta: metade da caixa aparece ao lado da parede
+  CHECK(!buffer.IsBoxOccluded(glm::vec3(-2.0f, -1.0f, -20.0f), glm::vec3(2.0f, 1.0f, -18.0f)));
+
+  // Na metade sem oclusor
+  CHECK(!buffer.IsBoxOccluded(glm::vec3(4.0f, -1.0f, -20.0f), glm::vec3(8.0f, 1.0f, -18.0f)));
+}
+
+TEST(OcclusionClearResetsBuffer)
+{
+  OcclusionBuffer buffer;
+  ClearWithTestCamera(buffer);
+
+  buffer.AddOccluder(glm::vec3(-50.0f, -50.0f, -6.0f), glm::vec3(50.0f, 50.0f, -5.0f));
+
+  ClearWithTestCamera(buffer);
+
+  CHECK(buffer.GetTriangleCount() == 0);
+  CHECK(!buffer.IsBoxOccluded(glm::vec3(-1.0f, -1.0f, -20.0f), glm::vec3(1.0f, 1.0f, -18.0f)));
+}
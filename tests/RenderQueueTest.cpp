@@ -0,0 +1,326 @@
+#include <algorithm>
+#include <random>
+#include <set>
+#include <tuple>
+
+#include "core.h"
+
+#include "Test.hpp"
+
+#include "engine/RecordingBackend.hpp"
+#include "engine/RenderQueue.hpp"
+
+// Distâncias dos testes ficam abaixo dela, exceto no teste de ordenação, que também exercita a saturação
+static const float FAR_DISTANCE = 1024.0f;
+
+// Pacote indexado de um único estado; o identificador vai na contagem de índices para ser achado no replay
+static DrawPacket MakePacket(unsigned int id, unsigned int program, unsigned int texture, unsigned int vertexArray)
+{
+  DrawPacket packet;
+
+  packet.program = program;
+  packet.vertexArray = vertexArray;
+  packet.indexBuffer = vertexArray;
+  packet.AddTexture(0, GL_TEXTURE_2D, texture);
+  packet.command = DC_ELEMENTS;
+  packet.elementCount = static_cast<int>(id) + 1;
+
+  return packet;
+}
+
+// Desenho reconstruído a partir dos comandos gravados, com o estado que estava ligado quando ele foi feito
+struct ReplayedDraw
+{
+  unsigned int id;
+  DrawPass pass;
+  unsigned int program;
+  unsigned int texture;
+  unsigned int vertexArray;
+  unsigned int indexBuffer;
+};
+
+// Reexecuta os comandos gravados acompanhando o estado, como o driver faria
+static std::vector<ReplayedDraw> Replay(const RecordingBackend &backend)
+{
+  std::vector<ReplayedDraw> draws;
+
+  bool isDepthTested = false;
+  bool isBlended = false;
+
+  unsigned int program = 0;
+  unsigned int texture = 0;
+  unsigned int vertexArray = 0;
+  unsigned int indexBuffer = 0;
+
+  for (const RecordedCommand &command : backend.GetCommands())
+  {
+    switch (command.type)
+    {
+    case RC_SET_ENABLED:
+      if (command.arguments[0] == GL_DEPTH_TEST)
+        isDepthTested = command.arguments[1] != 0;
+      if (command.arguments[0] == GL_BLEND)
+        isBlended = command.arguments[1] != 0;
+      break;
+    case RC_USE_PROGRAM:
+      program = command.arguments[0];
+      break;
+    case RC_BIND_TEXTURE:
+      texture = command.arguments[2];
+      break;
+    case RC_BIND_VERTEX_ARRAY:
+      vertexArray = command.arguments[0];
+      indexBuffer = 0;
+      break;
+    case RC_BIND_INDEX_BUFFER:
+      indexBuffer = command.arguments[0];
+      break;
+    case RC_DRAW:
+    {
+      DrawPass pass = !isDepthTested ? DP_INTERFACE : isBlended ? DP_TRANSPARENT : DP_OPAQUE;
+
+      draws.push_back({command.arguments[1] - 1, pass, program, texture, vertexArray, indexBuffer});
+      break;
+    }
+    default:
+      break;
+    }
+  }
+
+  return draws;
+}
+
+// Cada desenho usa o estado do próprio pacote, ou seja, nenhuma mudança de estado necessária foi evitada
+static void CheckReplayedState(const RenderQueue &queue, const std::vector<ReplayedDraw> &draws)
+{
+  for (const ReplayedDraw &draw : draws)
+  {
+    const DrawPacket &packet = queue.GetPacket(draw.id);
+
+    CHECK(draw.program == packet.program);
+    CHECK(draw.texture == packet.textures[0].texture);
+    CHECK(draw.vertexArray == packet.vertexArray);
+    CHECK(draw.indexBuffer == packet.indexBuffer);
+  }
+}
+
+TEST(RenderQueueSortMatchesStableSort)
+{
+  std::mt19937 random(1234);
+
+  RenderQueue queue(FAR_DISTANCE);
+  RecordingBackend backend;
+
+  // Vários frames, para os buffers reaproveitados também serem exercitados
+  for (int frame = 0; frame < 4; frame++)
+  {
+    queue.Clear();
+
+    int packets = 500 + frame * 700;
+
+    for (int id = 0; id < packets; id++)
+    {
+      DrawPass pass = static_cast<DrawPass>(random() % DP_COUNT);
+      float distance = static_cast<float>(random() % 20000) / 10.0f;
+
+      queue.Submit(pass, distance, MakePacket(id, 1 + random() % 5, 1 + random() % 4, 1 + random() % 6));
+    }
+
+    // Antes da execução os itens estão na ordem de envio
+    std::vector<RenderQueue::SortItem> expected = queue.GetSortedItems();
+
+    std::stable_sort(expected.begin(), expected.end(), [](const RenderQueue::SortItem &a, const RenderQueue::SortItem &b)
+                     { return a.key < b.key; });
+
+    backend.Clear();
+    queue.Execute(backend);
+
+    const std::vector<RenderQueue::SortItem> &sorted = queue.GetSortedItems();
+
+    CHECK(sorted.size() == expected.size());
+
+    bool isEqual = sorted.size() == expected.size();
+
+    for (size_t i = 0; isEqual && i < sorted.size(); i++)
+      isEqual = sorted[i].key == expected[i].key && sorted[i].packet == expected[i].packet;
+
+    CHECK(isEqual);
+
+    // Todos os pacotes são desenhados uma vez, com o estado certo
+    std::vector<ReplayedDraw> draws = Replay(backend);
+
+    CHECK(static_cast<int>(draws.size()) == packets);
+    CHECK(queue.GetStats().drawCalls == packets);
+
+    CheckReplayedState(queue, draws);
+  }
+}
+
+TEST(RenderQueuePassOrdering)
+{
+  RenderQueue queue(FAR_DISTANCE);
+  RecordingBackend backend;
+
+  std::mt19937 random(42);
+
+  std::vector<float> distances(90);
+
+  // Pacotes dos três passes intercalados, com estados e distâncias embaralhados
+  for (unsigned int id = 0; id < distances.size(); id++)
+  {
+    DrawPass pass = static_cast<DrawPass>(id % DP_COUNT);
+
+    distances[id] = static_cast<float>(random() % 1000);
+
+    queue.Submit(pass, distances[id], MakePacket(id, 1 + random() % 3, 1 + random() % 3, 1 + random() % 3));
+  }
+
+  queue.Execute(backend);
+
+  std::vector<ReplayedDraw> draws = Replay(backend);
+
+  CHECK(draws.size() == distances.size());
+
+  CheckReplayedState(queue, draws);
+
+  // Os passes são executados em ordem, e cada pacote no próprio pass
+  for (size_t i = 0; i < draws.size(); i++)
+  {
+    CHECK(draws[i].pass == static_cast<DrawPass>(draws[i].id % DP_COUNT));
+
+    if (i > 0)
+      CHECK(draws[i - 1].pass <= draws[i].pass);
+  }
+
+  // Opaco: cada estado aparece em um único trecho contínuo, da profundidade mais próxima para a mais distante
+  std::set<std::tuple<unsigned int, unsigned int, unsigned int>> finishedStates;
+  std::set<unsigned int> opaquePrograms;
+
+  for (size_t i = 0; i < draws.size(); i++)
+  {
+    if (draws[i].pass != DP_OPAQUE)
+      continue;
+
+    auto state = std::make_tuple(draws[i].program, draws[i].texture, draws[i].vertexArray);
+
+    opaquePrograms.insert(draws[i].program);
+
+    bool continuesGroup = i > 0 && draws[i - 1].pass == DP_OPAQUE && std::make_tuple(draws[i - 1].program, draws[i - 1].texture, draws[i - 1].vertexArray) == state;
+
+    if (continuesGroup)
+      CHECK(queue.QuantizeDepth(distances[draws[i - 1].id]) <= queue.QuantizeDepth(distances[draws[i].id]));
+    else
+    {
+      CHECK(finishedStates.count(state) == 0);
+      finishedStates.insert(state);
+    }
+  }
+
+  // Os grupos opacos são ordenados pelo programa primeiro, então cada programa é ligado uma única vez no pass
+  int opaqueProgramBinds = 0;
+  bool isOpaque = false;
+
+  for (const RecordedCommand &command : backend.GetCommands())
+  {
+    if (command.type == RC_SET_ENABLED && command.arguments[0] == GL_BLEND)
+      isOpaque = command.arguments[1] == 0;
+
+    if (command.type == RC_USE_PROGRAM && isOpaque)
+      opaqueProgramBinds++;
+  }
+
+  CHECK(opaqueProgramBinds == static_cast<int>(opaquePrograms.size()));
+
+  // Transparente: da mais distante para a mais próxima
+  // Interface: na ordem de envio
+  const ReplayedDraw *previous = nullptr;
+
+  for (const ReplayedDraw &draw : draws)
+  {
+    if (previous && previous->pass == draw.pass && draw.pass == DP_TRANSPARENT)
+      CHECK(queue.QuantizeDepth(distances[previous->id]) >= queue.QuantizeDepth(distances[draw.id]));
+
+    if (previous && previous->pass == draw.pass && draw.pass == DP_INTERFACE)
+      CHECK(previous->id < draw.id);
+
+    previous = &draw;
+  }
+}
+
+TEST(RenderQueueElidesRepeatedState)
+{
+  RenderQueue queue(FAR_DISTANCE);
+  RecordingBackend backend;
+
+  // Quatro desenhos opacos com o mesmo estado, enviados de longe para perto
+  for (unsigned int id = 0; id < 4; id++)
+    queue.Submit(DP_OPAQUE, 100.0f - id * 10.0f, MakePacket(id, 7, 3, 5));
+
+  queue.Execute(backend);
+
+  // Programa, VAO, index buffer e textura são ligados uma vez e evitados nos outros três desenhos
+  CHECK(backend.GetCount(RC_USE_PROGRAM) == 1);
+  CHECK(backend.GetCount(RC_BIND_VERTEX_ARRAY) == 1);
+  CHECK(backend.GetCount(RC_BIND_INDEX_BUFFER) == 1);
+  CHECK(backend.GetCount(RC_BIND_TEXTURE) == 1);
+  CHECK(backend.GetCount(RC_DRAW) == 4);
+
+  const RenderQueueStats &stats = queue.GetStats();
+
+  CHECK(stats.packets == 4);
+  CHECK(stats.drawCalls == 4);
+  CHECK(stats.elidedStateChanges == 3 * 4);
+
+  // Estado do pass no início e no fim, mais as quatro ligações, todas no pass opaco
+  CHECK(stats.stateChanges == 3 + 4 + 3);
+  CHECK(stats.passStateChanges[DP_OPAQUE] == stats.stateChanges);
+  CHECK(stats.passStateChanges[DP_TRANSPARENT] == 0 && stats.passStateChanges[DP_INTERFACE] == 0);
+
+  // Os desenhos saem do mais perto para o mais longe
+  std::vector<ReplayedDraw> draws = Replay(backend);
+
+  CHECK(draws.size() == 4);
+
+  for (size_t i = 0; i < draws.size(); i++)
+    CHECK(draws[i].id == 3 - i);
+}
+
+TEST(RenderQueueStateCountsMatchCommands)
+{
+  std::mt19937 random(7);
+
+  RenderQueue queue(FAR_DISTANCE);
+  RecordingBackend backend;
+
+  int possibleBinds = 0;
+
+  for (unsigned int id = 0; id < 300; id++)
+  {
+    DrawPass pass = static_cast<DrawPass>(random() % DP_COUNT);
+
+    queue.Submit(pass, static_cast<float>(random() % 500), MakePacket(id, 1 + random() % 4, 1 + random() % 4, 1 + random() % 4));
+
+    // Programa, VAO, index buffer e uma textura por pacote
+    possibleBinds += 4;
+  }
+
+  queue.Execute(backend);
+
+  const RenderQueueStats &stats = queue.GetStats();
+
+  int binds = backend.GetCount(RC_USE_PROGRAM) + backend.GetCount(RC_BIND_VERTEX_ARRAY) + backend.GetCount(RC_BIND_INDEX_BUFFER) + backend.GetCount(RC_BIND_TEXTURE);
+  int passState = backend.GetCount(RC_SET_ENABLED) + backend.GetCount(RC_BLEND_FUNC) + backend.GetCount(RC_POLYGON_MODE);
+
+  // Toda mudança contada foi enviada ao backend, e cada ligação possível foi enviada ou evitada
+  CHECK(stats.stateChanges == binds + passState);
+  CHECK(binds + stats.elidedStateChanges == possibleBinds);
+  CHECK(stats.elidedStateChanges > 0);
+
+  // As contagens por pass repartem o total, e cada pass usado muda algum estado
+  CHECK(stats.passStateChanges[DP_OPAQUE] + stats.passStateChanges[DP_TRANSPARENT] + stats.passStateChanges[DP_INTERFACE] == stats.stateChanges);
+
+  for (int pass = 0; pass < DP_COUNT; pass++)
+    CHECK(stats.passStateChanges[pass] > 0);
+
+  CheckReplayedState(queue, Replay(backend));
+}
@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <map>
+#include <set>
+#include <tuple>
+
+#include "Test.hpp"
+
+#include "world/SectionVisibility.hpp"
+
+// Seção de pedra com um túnel de ar de (x0, y, z0) até (x1, y, z1), andando primeiro em x e depois em z
+static void CarveTunnel(ChunkSection &section, int x0, int z0, int x1, int z1, int y)
+{
+  for (int x = std::min(x0, x1); x <= std::max(x0, x1); x++)
+    section.SetCube(x, y, z0, AIR);
+
+  for (int z = std::min(z0, z1); z <= std::max(z0, z1); z++)
+    section.SetCube(x1, y, z, AIR);
+}
+
+static uint16_t GetConnection(int a, int b)
+{
+  return SectionVisibility::ConnectFaces((1 << a) | (1 << b));
+}
+
+TEST(SectionVisibilityEmptySection)
+{
+  ChunkSection section;
+
+  CHECK(SectionVisibility::ComputeConnectivity(section) == SectionVisibility::ALL_CONNECTED);
+}
+
+TEST(SectionVisibilitySolidSection)
+{
+  ChunkSection section;
+  section.Fill(STONE);
+
+  CHECK(SectionVisibility::ComputeConnectivity(section) == SectionVisibility::NONE_CONNECTED);
+}
+
+TEST(SectionVisibilityStraightTunnel)
+{
+  ChunkSection section;
+  section.Fill(STONE);
+
+  // De oeste a leste, longe das outras faces
+  CarveTunnel(section, 0, 8, WorldConstants::CHUNK_SIZE - 1, 8, 8);
+
+  uint16_t connectivity = SectionVisibility::ComputeConnectivity(section);
+
+  CHECK(connectivity == GetConnection(SF_WEST, SF_EAST));
+  CHECK(SectionVisibility::AreFacesConnected(connectivity, SF_WEST, SF_EAST));
+  CHECK(SectionVisibility::AreFacesConnected(connectivity, SF_EAST, SF_WEST));
+  CHECK(!SectionVisibility::AreFacesConnected(connectivity, SF_WEST, SF_UP));
+  CHECK(!SectionVisibility::AreFacesConnected(connectivity, SF_NORTH, SF_SOUTH));
+}
+
+TEST(SectionVisibilityLBendTunnel)
+{
+  ChunkSection section;
+  section.Fill(STONE);
+
+  // Entra pelo oeste e dobra para o sul no meio da seção
+  CarveTunnel(section, 0, 8, 8, WorldConstants::CHUNK_SIZE - 1, 8);
+
+  uint16_t connectivity = SectionVisibility::ComputeConnectivity(section);
+
+  CHECK(connectivity == GetConnection(SF_WEST, SF_SOUTH));
+  CHECK(!SectionVisibility::AreFacesConnected(connectivity, SF_WEST, SF_EAST));
+  CHECK(!SectionVisibility::AreFacesConnected(connectivity, SF_NORTH, SF_SOUTH));
+}
+
+TEST(SectionVisibilitySeparateRegions)
+{
+  ChunkSection section;
+  section.Fill(STONE);
+
+  // Um túnel de oeste a leste e um poço vertical que não se encontram
+  CarveTunnel(section, 0, 4, WorldConstants::CHUNK_SIZE - 1, 4, 8);
+
+  for (int y = 0; y < WorldConstants::SECTION_HEIGHT; y++)
+    section.SetCube(10, y, 12, AIR);
+
+  // Uma cavidade que só toca a face norte não liga nada
+  section.SetCube(3, 3, 0, AIR);
+
+  uint16_t connectivity = SectionVisibility::ComputeConnectivity(section);
+
+  CHECK(connectivity == (GetConnection(SF_WEST, SF_EAST) | GetConnection(SF_DOWN, SF_UP)));
+  CHECK(!SectionVisibility::AreFacesConnected(connectivity, SF_WEST, SF_UP));
+  CHECK(!SectionVisibility::AreFacesConnected(connectivity, SF_NORTH, SF_WEST));
+}
+
+TEST(SectionVisibilityTransparentBlocksConnect)
+{
+  ChunkSection section;
+  section.Fill(STONE);
+
+  // Água não é opaca, então também liga as faces
+  for (int z = 0; z < WorldConstants::CHUNK_SIZE; z++)
+    section.SetCube(5, 5, z, WATER);
+
+  CHECK(SectionVisibility::ComputeConnectivity(section) == GetConnection(SF_NORTH, SF_SOUTH));
+}
+
+// Mundo sintético de seções em volta da origem; posições sem entrada estão fora do mundo carregado
+struct TestWorld
+{
+  std::map<std::tuple<int, int, int>, uint16_t> connectivities;
+  std::set<std::tuple<int, int, int>> visited;
+
+  void Fill(int radius, uint16_t connectivity)
+  {
+    for (int x = -radius; x <= radius; x++)
+      for (int z = -radius; z <= radius; z++)
+        for (int y = 0; y < WorldConstants::SECTIONS_PER_CHUNK; y++)
+          connectivities[std::make_tuple(x, y, z)] = connectivity;
+  }
+
+  void Traverse(glm::ivec3 start, int radius)
+  {
+    SectionVisibility::Traverse(
+        start, radius,
+        [this](glm::ivec3 position)
+        {
+          auto it = connectivities.find(std::make_tuple(position.x, position.y, position.z));
+
+          return it == connectivities.end() ? -1 : static_cast<int>(it->second);
+        },
+        [this](glm::ivec3 position)
+        {
+          visited.insert(std::make_tuple(position.x, position.y, position.z));
+          return true;
+        });
+  }
+
+  bool WasVisited(int x, int y, int z) const { return visited.count(std::make_tuple(x, y, z)) > 0; }
+};
+
+TEST(SectionVisibilityTraverseWall)
+{
+  TestWorld world;
+  world.Fill(5, SectionVisibility::ALL_CONNECTED);
+
+  // Parede de seções opacas em x = 1, em todas as alturas
+  for (int z = -3; z <= 3; z++)
+    for (int y = 0; y < WorldConstants::SECTIONS_PER_CHUNK; y++)
+      world.connectivities[std::make_tuple(1, y, z)] = SectionVisibility::NONE_CONNECTED;
+
+  world.Traverse(glm::ivec3(0, 5, 0), 3);
+
+  // A parede é visitada, mas nada atrás dela
+  CHECK(world.WasVisited(0, 5, 0));
+  CHECK(world.WasVisited(-3, 5, 0));
+  CHECK(world.WasVisited(-2, 0, 3));
+  CHECK(world.WasVisited(1, 5, 0));
+  CHECK(world.WasVisited(1, 9, -2));
+  CHECK(!world.WasVisited(2, 5, 0));
+  CHECK(!world.WasVisited(3, 0, 3));
+
+  // O raio limita o percurso, mesmo com o mundo carregado além dele
+  CHECK(!world.WasVisited(-4, 5, 0));
+}
+
+TEST(SectionVisibilityTraverseTunnel)
+{
+  TestWorld world;
+  world.Fill(3, GetConnection(SF_WEST, SF_EAST));
+
+  world.Traverse(glm::ivec3(0, 5, 0), 3);
+
+  // O túnel é percorrido de ponta a ponta
+  for (int x = -3; x <= 3; x++)
+    CHECK(world.WasVisited(x, 5, 0));
+
+  // Os vizinhos da seção da câmera são vistos, mas não ligam a entrada a nenhuma outra face
+  CHECK(world.WasVisited(0, 6, 0));
+  CHECK(world.WasVisited(0, 5, 1));
+  CHECK(!world.WasVisited(0, 7, 0));
+  CHECK(!world.WasVisited(1, 6, 0));
+  CHECK(!world.WasVisited(2, 5, 1));
+}
+
+TEST(SectionVisibilityTraverseUnloadedStart)
+{
+  TestWorld world;
+
+  world.Traverse(glm::ivec3(0, 5, 0), 3);
+
+  CHECK(world.visited.empty());
+}
@@ -0,0 +1,64 @@
+#ifndef _TEST_H
+#define _TEST_H
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// Caso de teste registrado com TEST
+struct TestCase
+{
+  const char *name;
+  void (*function)();
+};
+
+// Registro dos testes: cada arquivo de tests/ define os casos com TEST e o tests/main.cpp roda todos
+// Os testes não usam janela nem GPU, só as partes do engine que rodam na CPU
+class TestRegistry
+{
+private:
+  TestRegistry() {}
+
+public:
+  static std::vector<TestCase> &GetTests()
+  {
+    static std::vector<TestCase> tests;
+    return tests;
+  }
+
+  static int Register(const char *name, void (*function)())
+  {
+    GetTests().push_back({name, function});
+    return static_cast<int>(GetTests().size());
+  }
+
+  // Falhas do teste em execução
+  static int &GetFailures()
+  {
+    static int failures = 0;
+    return failures;
+  }
+
+  static void Fail(const char *file, int line, const char *expression)
+  {
+    printf("  %s:%d: CHECK(%s) failed \n", file, line, expression);
+    GetFailures()++;
+  }
+};
+
+#define TEST(name)                                                                    \
+  static void name();                                                                 \
+  static const int name##Registration = TestRegistry::Register(#name, name);          \
+  static void name()
+
+// Registra a falha e continua o teste, para mostrar todas as verificações que falham
+#define CHECK(expression)                                   \
+  do                                                        \
+  {                                                         \
+    if (!(expression))                                      \
+      TestRegistry::Fail(__FILE__, __LINE__, #expression);  \
+  } while (0)
+
+#define CHECK_NEAR(a, b, tolerance) CHECK(std::fabs((a) - (b)) <= (tolerance))
+
+#endif
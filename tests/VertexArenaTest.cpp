@@ -0,0 +1,75 @@
+#include <vector>
+
+#include "core.h"
+
+#include "Test.hpp"
+
+#include "engine/NullBackend.hpp"
+#include "engine/VertexArena.hpp"
+
+// Arena de vértices de um uint, sobre o backend nulo, que registra os bytes copiados entre buffers
+static VertexArena *CreateTestArena(int pages)
+{
+  NullBackend::Load();
+
+  VertexBufferLayout layout;
+  layout.Push(LayoutType::LT_UINT, 1);
+
+  return new VertexArena(layout, sizeof(unsigned int), pages);
+}
+
+TEST(VertexArenaDefragmentCopiesLiveAllocations)
+{
+  const int pageBytes = VertexArena::PAGE_VERTICES * sizeof(unsigned int);
+
+  VertexArena *arena = CreateTestArena(16);
+
+  std::vector<unsigned int> vertices(4 * VertexArena::PAGE_VERTICES, 0);
+
+  // Páginas [0, 1), [1, 3), [3, 4) e [4, 7)
+  int a = arena->Allocate(vertices.data(), VertexArena::PAGE_VERTICES, glm::ivec2(0));
+  int b = arena->Allocate(vertices.data(), 2 * VertexArena::PAGE_VERTICES, glm::ivec2(0));
+  int c = arena->Allocate(vertices.data(), VertexArena::PAGE_VERTICES, glm::ivec2(0));
+  int d = arena->Allocate(vertices.data(), 3 * VertexArena::PAGE_VERTICES, glm::ivec2(0));
+
+  arena->Free(b);
+
+  NullBackend::ResetStats();
+
+  arena->Defragment();
+
+  // Só as 5 páginas vivas são copiadas: a no lugar, c e d nas posições novas
+  CHECK(NullBackend::GetStats().copiedBytes == 5 * pageBytes);
+
+  CHECK(arena->GetFirst(a) == 0);
+  CHECK(arena->GetFirst(c) == VertexArena::PAGE_VERTICES);
+  CHECK(arena->GetFirst(d) == 2 * VertexArena::PAGE_VERTICES);
+
+  // Sem buracos, nada é copiado
+  NullBackend::ResetStats();
+
+  arena->Defragment();
+
+  CHECK(NullBackend::GetStats().copiedBytes == 0);
+
+  delete arena;
+}
+
+TEST(VertexArenaCountsFailedAllocations)
+{
+  VertexArena *arena = CreateTestArena(16);
+
+  CHECK(arena->GetStats().failedAllocations == 0);
+
+  // Mais páginas do que a arena comporta mesmo no tamanho máximo
+  std::vector<unsigned int> vertices((VertexArena::MAX_PAGES + 1) * VertexArena::PAGE_VERTICES, 0);
+
+  CHECK(arena->Allocate(vertices.data(), static_cast<int>(vertices.size()), glm::ivec2(0)) == BufferAllocator::INVALID);
+  CHECK(arena->GetStats().failedAllocations == 1);
+
+  // Uma alocação que cabe continua funcionando e não conta como falha
+  CHECK(arena->Allocate(vertices.data(), VertexArena::PAGE_VERTICES, glm::ivec2(0)) != BufferAllocator::INVALID);
+  CHECK(arena->GetStats().failedAllocations == 1);
+
+  delete arena;
+}
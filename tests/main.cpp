@@ -0,0 +1,45 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "core.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+
+#include <stb_image/stb_image.h>
+
+#define TINYOBJLOADER_IMPLEMENTATION
+
+#include <tiny_obj_loader/tiny_obj_loader.h>
+
+#include "Test.hpp"
+
+// Roda todos os testes, ou só os que contêm o filtro no nome
+int main(int argc, char *argv[])
+{
+  const char *filter = argc > 1 ? argv[1] : nullptr;
+
+  int run = 0;
+  int failed = 0;
+
+  for (const TestCase &test : TestRegistry::GetTests())
+  {
+    if (filter && !strstr(test.name, filter))
+      continue;
+
+    TestRegistry::GetFailures() = 0;
+
+    test.function();
+
+    bool passed = TestRegistry::GetFailures() == 0;
+
+    printf("%s %s \n", passed ? "PASS" : "FAIL", test.name);
+
+    run++;
+    failed += passed ? 0 : 1;
+  }
+
+  printf("%d tests, %d failed \n", run, failed);
+
+  return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}